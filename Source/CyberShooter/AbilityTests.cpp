@@ -0,0 +1,79 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#include "Ability.h"
+#include "CyberShooterGameInstance.h"
+#include "CyberShooter.h"
+
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+#include "UObject/UObjectIterator.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Count the live ability scripts in memory
+static int32 CountAbilityScripts()
+{
+	int32 count = 0;
+	for (TObjectIterator<UAbilityScript> it; it; ++it)
+	{
+		if (!it->IsPendingKill())
+		{
+			count++;
+		}
+	}
+	return count;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAbilityScriptAllocationTest, "CyberShooter.Ability.ScriptAllocations", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FAbilityScriptAllocationTest::RunTest(const FString& Parameters)
+{
+	UCyberShooterGameInstance* instance = NewObject<UCyberShooterGameInstance>(GetTransientPackage());
+
+	// Two abilities sharing a script class and one without a script
+	UAbility* first = NewObject<UAbility>(GetTransientPackage());
+	UAbility* second = NewObject<UAbility>(GetTransientPackage());
+	UAbility* empty = NewObject<UAbility>(GetTransientPackage());
+	first->Script = UAbilityScript::StaticClass();
+	second->Script = UAbilityScript::StaticClass();
+
+	TArray<UObject*> owned;
+	GetObjectsWithOuter(instance, owned, false);
+	const int32 owned_before = owned.Num();
+	const int32 scripts_before = CountAbilityScripts();
+	instance->PreloadScripts({ first, second, empty, nullptr });
+
+	owned.Reset();
+	GetObjectsWithOuter(instance, owned, false);
+	TestEqual(TEXT("Preloading creates one script per script class"), owned.Num(), owned_before + 1);
+	TestEqual(TEXT("Preloading allocates one script"), CountAbilityScripts(), scripts_before + 1);
+
+	// Each activation and deactivation looks the script up again
+	UAbilityScript* script = instance->GetScript(first->Script);
+	const int32 scripts_preloaded = CountAbilityScripts();
+	const int32 uses = 1000;
+	for (int32 i = 0; i < uses; ++i)
+	{
+		UAbility* ability = (i & 1) ? second : first;
+		if (instance->GetScript(ability->Script) != script || instance->GetScript(empty->Script) != nullptr)
+		{
+			AddError(FString::Printf(TEXT("Ability use %d returned the wrong script"), i));
+			break;
+		}
+	}
+
+	owned.Reset();
+	GetObjectsWithOuter(instance, owned, false);
+	TestEqual(TEXT("Repeated use creates no scripts"), owned.Num(), owned_before + 1);
+	TestEqual(TEXT("Repeated use allocates no scripts"), CountAbilityScripts(), scripts_preloaded);
+
+	instance->MarkPendingKill();
+	first->MarkPendingKill();
+	second->MarkPendingKill();
+	empty->MarkPendingKill();
+
+	return true;
+}
+
+#endif
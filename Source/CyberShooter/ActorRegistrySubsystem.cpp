@@ -0,0 +1,238 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#include "ActorRegistrySubsystem.h"
+#include "LevelTrigger.h"
+#include "Lock.h"
+#include "CheckpointTrigger.h"
+#include "AggroZone.h"
+#include "Spawner.h"
+#include "CyberShooterPlayer.h"
+#include "CyberShooter.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+static FAutoConsoleCommandWithWorld DumpRegistryCommand(
+	TEXT("cs.DumpRegistry"),
+	TEXT("Log every actor held by the actor registry."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		UActorRegistrySubsystem* registry = World->GetSubsystem<UActorRegistrySubsystem>();
+		if (registry != nullptr)
+		{
+			registry->Dump();
+		}
+	}));
+
+UActorRegistrySubsystem::UActorRegistrySubsystem()
+{
+	Player = nullptr;
+}
+
+void UActorRegistrySubsystem::Deinitialize()
+{
+	LevelTriggers.Empty();
+	Locks.Empty();
+	Checkpoints.Empty();
+	AggroZones.Empty();
+	BakedZones.Empty();
+	Spawners.Empty();
+	CombatTargets.Empty();
+	Player = nullptr;
+
+	Super::Deinitialize();
+}
+
+/// Registration ///
+
+void UActorRegistrySubsystem::Register(ALevelTrigger* Trigger)
+{
+	ALevelTrigger*& entry = LevelTriggers.FindOrAdd(Trigger->GetID());
+	if (entry != nullptr && entry != Trigger)
+	{
+		UE_LOG(LogCyberShooter, Warning, TEXT("Level triggers %s and %s share ID %u"), *entry->GetName(), *Trigger->GetName(), Trigger->GetID());
+	}
+	entry = Trigger;
+}
+
+void UActorRegistrySubsystem::Unregister(ALevelTrigger* Trigger)
+{
+	if (LevelTriggers.FindRef(Trigger->GetID()) == Trigger)
+	{
+		LevelTriggers.Remove(Trigger->GetID());
+	}
+}
+
+void UActorRegistrySubsystem::Register(ALock* Lock)
+{
+	if (Lock->GetID() < 0)
+		return;
+
+	ALock*& entry = Locks.FindOrAdd(Lock->GetID());
+	if (entry != nullptr && entry != Lock)
+	{
+		UE_LOG(LogCyberShooter, Warning, TEXT("Locks %s and %s share ID %d"), *entry->GetName(), *Lock->GetName(), Lock->GetID());
+	}
+	entry = Lock;
+}
+
+void UActorRegistrySubsystem::Unregister(ALock* Lock)
+{
+	if (Locks.FindRef(Lock->GetID()) == Lock)
+	{
+		Locks.Remove(Lock->GetID());
+	}
+}
+
+void UActorRegistrySubsystem::Register(ACheckpointTrigger* Checkpoint)
+{
+	Checkpoints.Add(Checkpoint);
+}
+
+void UActorRegistrySubsystem::Unregister(ACheckpointTrigger* Checkpoint)
+{
+	Checkpoints.Remove(Checkpoint);
+}
+
+void UActorRegistrySubsystem::Register(AAggroZone* Zone)
+{
+	AggroZones.Add(Zone);
+
+	// Zones register before any actor in the level begins play, so actors can look up their baked zones in BeginPlay
+	if (Zone->IsMembershipBaked())
+	{
+		const TArray<AActor*>& actors = Zone->GetActors();
+		for (int32 i = 0; i < actors.Num(); ++i)
+		{
+			if (actors[i] != nullptr)
+			{
+				BakedZones.AddUnique(actors[i], Zone);
+			}
+		}
+	}
+}
+
+void UActorRegistrySubsystem::Unregister(AAggroZone* Zone)
+{
+	AggroZones.Remove(Zone);
+
+	const TArray<AActor*>& actors = Zone->GetActors();
+	for (int32 i = 0; i < actors.Num(); ++i)
+	{
+		BakedZones.RemoveSingle(actors[i], Zone);
+	}
+}
+
+void UActorRegistrySubsystem::Register(ASpawner* Spawner)
+{
+	Spawners.Add(Spawner);
+}
+
+void UActorRegistrySubsystem::Unregister(ASpawner* Spawner)
+{
+	Spawners.Remove(Spawner);
+}
+
+void UActorRegistrySubsystem::Register(ACyberShooterPlayer* NewPlayer)
+{
+	Player = NewPlayer;
+}
+
+void UActorRegistrySubsystem::Unregister(ACyberShooterPlayer* OldPlayer)
+{
+	if (Player == OldPlayer)
+	{
+		Player = nullptr;
+	}
+}
+
+void UActorRegistrySubsystem::RegisterCombatTarget(AActor* Target)
+{
+	CombatTargets.Add(Target);
+}
+
+void UActorRegistrySubsystem::UnregisterCombatTarget(AActor* Target)
+{
+	CombatTargets.Remove(Target);
+}
+
+/// Lookups ///
+
+ALevelTrigger* UActorRegistrySubsystem::FindLevelTrigger(uint32 ID) const
+{
+	return LevelTriggers.FindRef(ID);
+}
+
+ALock* UActorRegistrySubsystem::FindLock(int32 ID) const
+{
+	return Locks.FindRef(ID);
+}
+
+void UActorRegistrySubsystem::FindBakedZones(const AActor* Actor, TArray<AAggroZone*>& OutZones) const
+{
+	BakedZones.MultiFind(Actor, OutZones);
+}
+
+UActorRegistrySubsystem* UActorRegistrySubsystem::Get(const UObject* WorldContextObject)
+{
+	UWorld* world = GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull);
+	if (world != nullptr)
+	{
+		return world->GetSubsystem<UActorRegistrySubsystem>();
+	}
+
+	return nullptr;
+}
+
+ACyberShooterPlayer* UActorRegistrySubsystem::FindPlayer(const UObject* WorldContextObject)
+{
+	UActorRegistrySubsystem* registry = Get(WorldContextObject);
+	if (registry != nullptr)
+	{
+		return registry->GetPlayer();
+	}
+
+	return nullptr;
+}
+
+void UActorRegistrySubsystem::Dump() const
+{
+	UE_LOG(LogCyberShooter, Log, TEXT("Player: %s"), Player != nullptr ? *Player->GetName() : TEXT("none"));
+
+	UE_LOG(LogCyberShooter, Log, TEXT("%d level triggers"), LevelTriggers.Num());
+	for (const TPair<uint32, ALevelTrigger*>& entry : LevelTriggers)
+	{
+		UE_LOG(LogCyberShooter, Log, TEXT("  %u: %s"), entry.Key, *GetNameSafe(entry.Value));
+	}
+
+	UE_LOG(LogCyberShooter, Log, TEXT("%d locks"), Locks.Num());
+	for (const TPair<int32, ALock*>& entry : Locks)
+	{
+		UE_LOG(LogCyberShooter, Log, TEXT("  %d: %s"), entry.Key, *GetNameSafe(entry.Value));
+	}
+
+	UE_LOG(LogCyberShooter, Log, TEXT("%d checkpoints"), Checkpoints.Num());
+	for (const ACheckpointTrigger* checkpoint : Checkpoints)
+	{
+		UE_LOG(LogCyberShooter, Log, TEXT("  %s"), *GetNameSafe(checkpoint));
+	}
+
+	UE_LOG(LogCyberShooter, Log, TEXT("%d aggro zones, %d baked memberships"), AggroZones.Num(), BakedZones.Num());
+	for (const AAggroZone* zone : AggroZones)
+	{
+		UE_LOG(LogCyberShooter, Log, TEXT("  %s"), *GetNameSafe(zone));
+	}
+
+	UE_LOG(LogCyberShooter, Log, TEXT("%d spawners"), Spawners.Num());
+	for (const ASpawner* spawner : Spawners)
+	{
+		UE_LOG(LogCyberShooter, Log, TEXT("  %s"), *GetNameSafe(spawner));
+	}
+
+	UE_LOG(LogCyberShooter, Log, TEXT("%d combat targets"), CombatTargets.Num());
+	for (const AActor* target : CombatTargets)
+	{
+		UE_LOG(LogCyberShooter, Log, TEXT("  %s"), *GetNameSafe(target));
+	}
+}
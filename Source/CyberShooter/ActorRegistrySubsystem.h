@@ -0,0 +1,90 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ActorRegistrySubsystem.generated.h"
+
+class ALevelTrigger;
+class ALock;
+class ACheckpointTrigger;
+class AAggroZone;
+class ASpawner;
+class ACyberShooterPlayer;
+
+// Typed lists of gameplay actors, filled as actors initialize so lookups don't need to search the world
+UCLASS()
+class CYBERSHOOTER_API UActorRegistrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UActorRegistrySubsystem();
+
+	virtual void Deinitialize() override;
+
+	/// Registration ///
+
+	void Register(ALevelTrigger* Trigger);
+	void Unregister(ALevelTrigger* Trigger);
+	void Register(ALock* Lock);
+	void Unregister(ALock* Lock);
+	void Register(ACheckpointTrigger* Checkpoint);
+	void Unregister(ACheckpointTrigger* Checkpoint);
+	void Register(AAggroZone* Zone);
+	void Unregister(AAggroZone* Zone);
+	void Register(ASpawner* Spawner);
+	void Unregister(ASpawner* Spawner);
+	void Register(ACyberShooterPlayer* NewPlayer);
+	void Unregister(ACyberShooterPlayer* OldPlayer);
+
+	// Add an actor implementing ICombatInterface to the combat target list
+	void RegisterCombatTarget(AActor* Target);
+	void UnregisterCombatTarget(AActor* Target);
+
+	/// Lookups ///
+
+	// Find the level trigger with an ID, or null if there isn't one
+	ALevelTrigger* FindLevelTrigger(uint32 ID) const;
+	// Find the lock with a save ID, or null if there isn't one
+	ALock* FindLock(int32 ID) const;
+	// Get the zones with baked membership that control an actor
+	void FindBakedZones(const AActor* Actor, TArray<AAggroZone*>& OutZones) const;
+
+	FORCEINLINE ACyberShooterPlayer* GetPlayer() const { return Player; }
+	FORCEINLINE const TSet<ACheckpointTrigger*>& GetCheckpoints() const { return Checkpoints; }
+	FORCEINLINE const TSet<AAggroZone*>& GetAggroZones() const { return AggroZones; }
+	FORCEINLINE const TSet<ASpawner*>& GetSpawners() const { return Spawners; }
+	FORCEINLINE const TSet<AActor*>& GetCombatTargets() const { return CombatTargets; }
+
+	// Get the registry for the world an object is in
+	static UActorRegistrySubsystem* Get(const UObject* WorldContextObject);
+	// Get the player pawn for the world an object is in
+	static ACyberShooterPlayer* FindPlayer(const UObject* WorldContextObject);
+
+	// Write the contents of every registry to the log
+	void Dump() const;
+
+protected:
+	// Level triggers by trigger ID
+	UPROPERTY()
+		TMap<uint32, ALevelTrigger*> LevelTriggers;
+	// Locks by save ID, locks that don't save are left out
+	UPROPERTY()
+		TMap<int32, ALock*> Locks;
+	UPROPERTY()
+		TSet<ACheckpointTrigger*> Checkpoints;
+	UPROPERTY()
+		TSet<AAggroZone*> AggroZones;
+	// Zones with baked membership keyed by the actors they control, built from each zone's saved actor list
+	TMultiMap<const AActor*, AAggroZone*> BakedZones;
+	UPROPERTY()
+		TSet<ASpawner*> Spawners;
+	// Pawns and destructibles that can take damage
+	UPROPERTY()
+		TSet<AActor*> CombatTargets;
+	// The player pawn
+	UPROPERTY()
+		ACyberShooterPlayer* Player;
+};
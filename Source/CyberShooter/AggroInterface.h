@@ -38,4 +38,6 @@ public:
 
 	// Register a parent aggro zone
 	virtual void RegisterZone(class AAggroZone* Zone) = 0;
+	// Called for each actor when a zone bakes its membership, returns true if the zone should count the object as an enemy
+	virtual bool BakeZone(class AAggroZone* Zone) { return false; };
 };
@@ -1,13 +1,20 @@
 // Copyright © 2020 Brian Faubion. All rights reserved.
 
 #include "AggroZone.h"
+#include "GameplayLog.h"
 
 #include "CyberShooterPlayer.h"
 #include "CyberShooterEnemy.h"
 #include "Spawner.h"
 #include "OrientationInterface.h"
+#include "DormancySubsystem.h"
+#include "ActorRegistrySubsystem.h"
+#include "CyberShooter.h"
 
 #include "Components/BoxComponent.h"
+#include "Engine/LevelStreaming.h"
+#include "Engine/LevelScriptActor.h"
+#include "GameFramework/WorldSettings.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/Engine.h"
 
@@ -39,9 +46,16 @@ AAggroZone::AAggroZone()
 	RespawnActors = true;
 	RespawnTime = 600.0f;
 
+	UseDormancy = true;
+	DormancyDelay = 10.0f;
+
 	Active = true;
 	Cleared = false;
 	Aggro = false;
+	Dormant = false;
+
+	MembershipBaked = false;
+	BakedEnemies = 0;
 
 	TotalEnemies = 0;
 	DespawnedEnemies = 0;
@@ -49,6 +63,9 @@ AAggroZone::AAggroZone()
 	SetCamera = false;
 	CameraDistance = 1500.0f;
 
+	RoomStreamingLevel = nullptr;
+	RoomRequests = 0;
+
 #if WITH_EDITOR
 	OrientationArrow = CreateDefaultSubobject<UArrowComponent>(TEXT("UpArrow"));
 	OrientationArrow->SetupAttachment(RootComponent);
@@ -59,17 +76,50 @@ AAggroZone::AAggroZone()
 #endif
 }
 
+void AAggroZone::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// Add the actor to the world's registry
+	UActorRegistrySubsystem* registry = GetWorld()->GetSubsystem<UActorRegistrySubsystem>();
+	if (registry != nullptr)
+	{
+		registry->Register(this);
+	}
+}
+
+void AAggroZone::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UActorRegistrySubsystem* registry = GetWorld()->GetSubsystem<UActorRegistrySubsystem>();
+	if (registry != nullptr)
+	{
+		registry->Unregister(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void AAggroZone::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// Register the aggro zone with actors inside it
-	for (int32 i = 0; i < Actors.Num(); ++i)
+	RebuildActorIndex();
+
+	if (MembershipBaked)
 	{
-		IAggroInterface* object = Cast<IAggroInterface>(Actors[i]);
-		if (object != nullptr)
+		// Actors looked up this zone in the registry's baked membership table
+		TotalEnemies = BakedEnemies;
+	}
+	else
+	{
+		// Register the aggro zone with actors inside it
+		for (int32 i = 0; i < Actors.Num(); ++i)
 		{
-			object->RegisterZone(this);
+			IAggroInterface* object = Cast<IAggroInterface>(Actors[i]);
+			if (object != nullptr)
+			{
+				object->RegisterZone(this);
+			}
 		}
 	}
 
@@ -78,6 +128,58 @@ void AAggroZone::BeginPlay()
 	{
 		Disable();
 	}
+
+	// Find the room level among the world's sublevels
+	if (!RoomLevel.IsNull())
+	{
+		const FString package_name = RoomLevel.GetLongPackageName();
+		for (ULevelStreaming* level : GetWorld()->GetStreamingLevels())
+		{
+			if (level != nullptr && UWorld::RemovePIEPrefix(level->GetWorldAssetPackageName()) == package_name)
+			{
+				RoomStreamingLevel = level;
+				break;
+			}
+		}
+
+		if (RoomStreamingLevel != nullptr)
+		{
+			RoomStreamingLevel->OnLevelShown.AddDynamic(this, &AAggroZone::RoomShown);
+			RoomStreamingLevel->OnLevelHidden.AddDynamic(this, &AAggroZone::RoomHidden);
+			RoomStreamingLevel->OnLevelUnloaded.AddDynamic(this, &AAggroZone::RoomUnloaded);
+			if (RoomStreamingLevel->IsLevelVisible())
+			{
+				RoomShown();
+			}
+		}
+		else
+		{
+			UE_LOG(LogCyberShooter, Warning, TEXT("Aggro zone %s: room level %s is not a sublevel of %s"), *GetName(), *package_name, *GetWorld()->GetMapName());
+		}
+	}
+
+	// Hold a reference to every actor in the dormancy set and wait for the player to show up
+	if (UseDormancy)
+	{
+		UDormancySubsystem* dormancy = GetWorld()->GetSubsystem<UDormancySubsystem>();
+		if (dormancy != nullptr)
+		{
+			for (int32 i = 0; i < Actors.Num(); ++i)
+			{
+				dormancy->WakeActor(Actors[i]);
+			}
+			for (int32 i = 0; i < DormancyActors.Num(); ++i)
+			{
+				dormancy->WakeActor(DormancyActors[i]);
+			}
+		}
+
+		UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+		if (timers != nullptr)
+		{
+			timers->SetTimer(TimerHandle_DormancyTimer, this, &AAggroZone::SleepZone, DormancyDelay);
+		}
+	}
 }
 
 void AAggroZone::BeginOverlap(AActor* OverlappedActor, AActor* OtherActor)
@@ -85,6 +187,18 @@ void AAggroZone::BeginOverlap(AActor* OverlappedActor, AActor* OtherActor)
 	ACyberShooterPlayer* player = Cast<ACyberShooterPlayer>(OtherActor);
 	if (player != nullptr)
 	{
+		WakeZone();
+
+		// Load this room and the rooms next to it
+		RequestRoom();
+		for (int32 i = 0; i < AdjacentZones.Num(); ++i)
+		{
+			if (AdjacentZones[i] != nullptr)
+			{
+				AdjacentZones[i]->RequestRoom();
+			}
+		}
+
 		// Ignore the player entering the zone if it is inactive
 		if (!Active)
 		{
@@ -117,9 +231,10 @@ void AAggroZone::BeginOverlap(AActor* OverlappedActor, AActor* OtherActor)
 		}
 
 		// Cancel the respawn timer
-		if (GetWorld()->GetTimerManager().GetTimerRemaining(TimerHandle_RespawnTimer) > 0.0f)
+		UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+		if (timers != nullptr)
 		{
-			GetWorld()->GetTimerManager().ClearTimer(TimerHandle_RespawnTimer);
+			timers->ClearTimer(TimerHandle_RespawnTimer);
 		}
 
 		// Call blueprint events
@@ -130,14 +245,10 @@ void AAggroZone::BeginOverlap(AActor* OverlappedActor, AActor* OtherActor)
 	else if (RespawnActors)
 	{
 		// Cancel respawns if the enemy returns to the zone after leaving
-		for (int32 i = 0; i < Actors.Num(); ++i)
+		IAggroInterface** aggrotarget = ActorIndex.Find(OtherActor);
+		if (aggrotarget != nullptr)
 		{
-			if (Actors[i] == OtherActor)
-			{
-				IAggroInterface* aggrotarget = Cast<IAggroInterface>(Actors[i]);
-				aggrotarget->EnterAggro();
-				return;
-			}
+			(*aggrotarget)->EnterAggro();
 		}
 	}
 }
@@ -147,6 +258,23 @@ void AAggroZone::EndOverlap(AActor* OverlappedActor, AActor* OtherActor)
 	ACyberShooterPlayer* player = Cast<ACyberShooterPlayer>(OtherActor);
 	if (player != nullptr)
 	{
+		// Put the zone to sleep if the player stays away
+		UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+		if (UseDormancy && timers != nullptr)
+		{
+			timers->SetTimer(TimerHandle_DormancyTimer, this, &AAggroZone::SleepZone, DormancyDelay);
+		}
+
+		// Let the rooms unload if the player doesn't come back
+		ReleaseRoom();
+		for (int32 i = 0; i < AdjacentZones.Num(); ++i)
+		{
+			if (AdjacentZones[i] != nullptr)
+			{
+				AdjacentZones[i]->ReleaseRoom();
+			}
+		}
+
 		// Ignore the player leaving if the player didn't activate the zone when it entered
 		if (!Aggro)
 		{
@@ -170,9 +298,9 @@ void AAggroZone::EndOverlap(AActor* OverlappedActor, AActor* OtherActor)
 		}
 
 		// Start the respawn timer
-		if (RespawnActors)
+		if (RespawnActors && timers != nullptr)
 		{
-			GetWorld()->GetTimerManager().SetTimer(TimerHandle_RespawnTimer, this, &AAggroZone::Respawn, RespawnTime);
+			timers->SetTimer(TimerHandle_RespawnTimer, this, &AAggroZone::Respawn, RespawnTime);
 		}
 
 		// Call blueprint events
@@ -183,33 +311,44 @@ void AAggroZone::EndOverlap(AActor* OverlappedActor, AActor* OtherActor)
 	else if (RespawnActors)
 	{
 		// Respawn enemies that leave the zone
-		for (int32 i = 0; i < Actors.Num(); ++i)
+		IAggroInterface** aggrotarget = ActorIndex.Find(OtherActor);
+		if (aggrotarget != nullptr)
 		{
-			if (Actors[i] == OtherActor)
-			{
-				IAggroInterface* aggrotarget = Cast<IAggroInterface>(Actors[i]);
-				aggrotarget->ExitAggro();
-				return;
-			}
+			(*aggrotarget)->ExitAggro();
+			return;
 		}
 
 		// Check to see if the actor is a minion belonging to a spawner in the zone
 		AEnemyMinion* minion = Cast<AEnemyMinion>(OtherActor);
-		if (minion != nullptr)
+		if (minion != nullptr && minion->IsInZone(this))
 		{
-			for (int32 i = 0; i < Actors.Num(); ++i)
-			{
-				if (minion->IsParent(Actors[i]))
-				{
-					minion->StartRespawn();
-					return;
-				}
-			}
+			minion->StartRespawn();
 		}
 	}
 }
 
 void AAggroZone::UpdateActorList()
+{
+	// Zones can't reference actors in another level, streamed zones collect their actors at runtime
+	if (!RoomLevel.IsNull())
+	{
+		Actors.Empty();
+		DormancyActors.Empty();
+		MembershipBaked = false;
+		RebuildActorIndex();
+
+		UE_LOG(LogCyberShooter, Log, TEXT("Aggro zone %s collects its actors from its room level"), *GetName());
+		return;
+	}
+
+	GatherActors(Actors, DormancyActors);
+
+	// Any baked data is out of date now
+	MembershipBaked = false;
+	RebuildActorIndex();
+}
+
+void AAggroZone::GatherActors(TArray<AActor*>& OutActors, TArray<AActor*>& OutDormancyActors) const
 {
 	// Get all the enemies the aggro zone overlaps
 	TArray<TEnumAsByte<EObjectTypeQuery>> types;
@@ -218,40 +357,60 @@ void AAggroZone::UpdateActorList()
 	UKismetSystemLibrary::ComponentOverlapActors(CollisionBox, CollisionBox->GetComponentTransform(), types, AActor::StaticClass(), ignore, actors);
 
 	// Add overlapped enemies and spawners to the zone
-	Actors.Empty();
+	OutActors.Empty();
+	OutDormancyActors.Empty();
 	for (int32 i = 0; i < actors.Num(); ++i)
 	{
-		IAggroInterface* actor = Cast<IAggroInterface>(actors[i]);
-		if (actor != nullptr)
+		SortActor(actors[i], OutActors, OutDormancyActors);
+	}
+}
+
+void AAggroZone::SortActor(AActor* Actor, TArray<AActor*>& OutActors, TArray<AActor*>& OutDormancyActors) const
+{
+	IAggroInterface* actor = Cast<IAggroInterface>(Actor);
+	if (actor == nullptr)
+	{
+		// Other ticking gadgets in the zone go dormant along with it
+		if (Actor->PrimaryActorTick.bCanEverTick && Cast<ACyberShooterPlayer>(Actor) == nullptr && Cast<AAggroZone>(Actor) == nullptr)
 		{
-			// Check the orientation of relevant object
-			AEnemyBase* enemy = Cast<AEnemyBase>(actor);
-			if (enemy != nullptr)
-			{
-				if (!RootComponent->GetUpVector().Equals(enemy->GetUpVector()))
-				{
-					continue;
-				}
-			}
-			ADestructible* destructible = Cast<ADestructible>(actor);
-			if (destructible != nullptr)
-			{
-				if (!RootComponent->GetUpVector().Equals(destructible->GetActorUpVector()))
-				{
-					continue;
-				}
-			}
-			IOrientationInterface* object = Cast<IOrientationInterface>(actor);
-			if (object != nullptr)
-			{
-				if (!object->CheckOrientation(RootComponent->GetUpVector()))
-				{
-					continue;
-				}
-			}
+			OutDormancyActors.Add(Actor);
+		}
+		return;
+	}
 
-			// Add the actor
-			Actors.Add(actors[i]);
+	// Check the orientation of relevant object
+	AEnemyBase* enemy = Cast<AEnemyBase>(actor);
+	if (enemy != nullptr)
+	{
+		if (!RootComponent->GetUpVector().Equals(enemy->GetUpVector()))
+			return;
+	}
+	ADestructible* destructible = Cast<ADestructible>(actor);
+	if (destructible != nullptr)
+	{
+		if (!RootComponent->GetUpVector().Equals(destructible->GetActorUpVector()))
+			return;
+	}
+	IOrientationInterface* object = Cast<IOrientationInterface>(actor);
+	if (object != nullptr)
+	{
+		if (!object->CheckOrientation(RootComponent->GetUpVector()))
+			return;
+	}
+
+	// Add the actor
+	OutActors.Add(Actor);
+}
+
+void AAggroZone::RebuildActorIndex()
+{
+	ActorIndex.Empty(Actors.Num());
+	for (int32 i = 0; i < Actors.Num(); ++i)
+	{
+		IAggroInterface* object = Cast<IAggroInterface>(Actors[i]);
+		if (object != nullptr)
+		{
+			ActorIndex.Add(Actors[i], object);
 		}
 	}
 }
@@ -261,10 +420,16 @@ void AAggroZone::NotifyRegister()
 	TotalEnemies++;
 }
 
-void AAggroZone::NotifyDespawn()
+void AAggroZone::NotifyDespawn(AActor* Actor)
 {
 	DespawnedEnemies++;
 
+	// Remember which room actors are gone in case the room is unloaded before the zone respawns
+	if (RoomStreamingLevel != nullptr && Actor != nullptr)
+	{
+		DespawnedActors.Add(Actor->GetFName());
+	}
+
 	// Clear the zone
 	if (DespawnedEnemies >= TotalEnemies && !Cleared)
 	{
@@ -277,7 +442,7 @@ void AAggroZone::NotifyDespawn()
 		// Reset player camera
 		if (SetCamera)
 		{
-			ACyberShooterPlayer* player = Cast<ACyberShooterPlayer>(UGameplayStatics::GetPlayerPawn(GetWorld(), 0));
+			ACyberShooterPlayer* player = UActorRegistrySubsystem::FindPlayer(this);
 			if (player != nullptr)
 			{
 				player->ResetCameraDistance();
@@ -289,14 +454,19 @@ void AAggroZone::NotifyDespawn()
 
 		Cleared = true;
 
-		FString msg("Cleared zone ");
-		msg.Append(GetName());
-		GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Cyan, msg);
+		GAMEPLAY_EVENT(LogCyberShooterAggro, "Cleared zone", GetFName(), FColor::Cyan);
 	}
 }
 
 void AAggroZone::Respawn()
 {
+	// Wake dormant actors so the reset applies to their real state
+	const bool dormant = Dormant;
+	if (dormant)
+	{
+		WakeZone();
+	}
+
 	// Reset pawns
 	for (int32 i = 0; i < Actors.Num(); ++i)
 	{
@@ -307,15 +477,28 @@ void AAggroZone::Respawn()
 		}
 	}
 	DespawnedEnemies = 0;
+	DespawnedActors.Empty();
 
 	// Call blueprint events
 	OnRespawn.Broadcast();
 
-	GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Cyan, "Zone respawn");
+	if (dormant)
+	{
+		SleepZone();
+	}
+
+	GAMEPLAY_EVENT(LogCyberShooterAggro, "Zone respawn", GetFName(), FColor::Cyan);
 }
 
 void AAggroZone::Disable()
 {
+	// Wake dormant actors so waking them later doesn't restore their enabled state
+	const bool dormant = Dormant;
+	if (dormant)
+	{
+		WakeZone();
+	}
+
 	for (int32 i = 0; i < Actors.Num(); ++i)
 	{
 		IAggroInterface* object = Cast<IAggroInterface>(Actors[i]);
@@ -324,6 +507,11 @@ void AAggroZone::Disable()
 			object->AggroDisable();
 		}
 	}
+
+	if (dormant)
+	{
+		SleepZone();
+	}
 }
 
 void AAggroZone::Activate()
@@ -350,4 +538,295 @@ void AAggroZone::Deactivate()
 	// Update overlaps to activate the aggro zone if the player is inside it
 	ClearComponentOverlaps();
 	UpdateOverlaps();
-}
\ No newline at end of file
+}
+
+void AAggroZone::WakeZone()
+{
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers != nullptr)
+	{
+		timers->ClearTimer(TimerHandle_DormancyTimer);
+	}
+
+	if (Dormant)
+	{
+		Dormant = false;
+
+		UDormancySubsystem* dormancy = GetWorld()->GetSubsystem<UDormancySubsystem>();
+		if (dormancy != nullptr)
+		{
+			for (int32 i = 0; i < Actors.Num(); ++i)
+			{
+				dormancy->WakeActor(Actors[i]);
+			}
+			for (int32 i = 0; i < DormancyActors.Num(); ++i)
+			{
+				dormancy->WakeActor(DormancyActors[i]);
+			}
+		}
+	}
+}
+
+void AAggroZone::SleepZone()
+{
+	if (!Dormant && UseDormancy)
+	{
+		Dormant = true;
+
+		UDormancySubsystem* dormancy = GetWorld()->GetSubsystem<UDormancySubsystem>();
+		if (dormancy != nullptr)
+		{
+			for (int32 i = 0; i < Actors.Num(); ++i)
+			{
+				dormancy->SleepActor(Actors[i]);
+			}
+			for (int32 i = 0; i < DormancyActors.Num(); ++i)
+			{
+				dormancy->SleepActor(DormancyActors[i]);
+			}
+		}
+	}
+}
+
+int32 AAggroZone::CountTickingActors() const
+{
+	int32 count = 0;
+	for (int32 i = 0; i < Actors.Num(); ++i)
+	{
+		if (Actors[i] != nullptr && Actors[i]->IsActorTickEnabled())
+		{
+			count++;
+		}
+	}
+	for (int32 i = 0; i < DormancyActors.Num(); ++i)
+	{
+		if (DormancyActors[i] != nullptr && DormancyActors[i]->IsActorTickEnabled())
+		{
+			count++;
+		}
+	}
+
+	return count;
+}
+
+bool AAggroZone::ContainsActor(const AActor* Actor) const
+{
+	return Actors.Contains(Actor);
+}
+
+/// Room Streaming ///
+
+void AAggroZone::RequestRoom()
+{
+	if (RoomStreamingLevel == nullptr)
+		return;
+
+	RoomRequests++;
+
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers != nullptr)
+	{
+		timers->ClearTimer(TimerHandle_UnloadTimer);
+	}
+
+	if (!RoomStreamingLevel->ShouldBeLoaded())
+	{
+		GAMEPLAY_EVENT(LogCyberShooterAggro, "Loading room", GetFName(), FColor::Cyan);
+	}
+
+	RoomStreamingLevel->SetShouldBeLoaded(true);
+	RoomStreamingLevel->SetShouldBeVisible(true);
+}
+
+void AAggroZone::ReleaseRoom()
+{
+	if (RoomStreamingLevel == nullptr || RoomRequests <= 0)
+		return;
+
+	RoomRequests--;
+	if (RoomRequests > 0)
+		return;
+
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers != nullptr && RespawnTime > 0.0f)
+	{
+		timers->SetTimer(TimerHandle_UnloadTimer, this, &AAggroZone::UnloadRoom, RespawnTime);
+	}
+	else
+	{
+		UnloadRoom();
+	}
+}
+
+void AAggroZone::UnloadRoom()
+{
+	if (RoomStreamingLevel == nullptr || RoomRequests > 0)
+		return;
+
+	GAMEPLAY_EVENT(LogCyberShooterAggro, "Unloading room", GetFName(), FColor::Cyan);
+
+	RoomStreamingLevel->SetShouldBeVisible(false);
+	RoomStreamingLevel->SetShouldBeLoaded(false);
+}
+
+void AAggroZone::RoomShown()
+{
+	ULevel* level = RoomStreamingLevel != nullptr ? RoomStreamingLevel->GetLoadedLevel() : nullptr;
+	if (level == nullptr)
+		return;
+
+	// Collect the room's actors, skipping the actors every level has
+	Actors.Empty();
+	DormancyActors.Empty();
+	for (AActor* actor : level->Actors)
+	{
+		if (actor != nullptr && !actor->IsPendingKill() && !actor->IsA<AWorldSettings>() && !actor->IsA<ALevelScriptActor>())
+		{
+			SortActor(actor, Actors, DormancyActors);
+		}
+	}
+	RebuildActorIndex();
+
+	// Register with the new actors, cleared and despawned counts carry over from before the room was unloaded
+	TotalEnemies = 0;
+	for (const TPair<AActor*, IAggroInterface*>& entry : ActorIndex)
+	{
+		entry.Value->RegisterZone(this);
+
+		if (DespawnedActors.Contains(entry.Key->GetFName()) || (!Active && DisableActors))
+		{
+			entry.Value->AggroDisable();
+		}
+		else if (Aggro)
+		{
+			entry.Value->Aggro();
+		}
+	}
+
+	// Match the zone's dormancy state
+	if (UseDormancy)
+	{
+		UDormancySubsystem* dormancy = GetWorld()->GetSubsystem<UDormancySubsystem>();
+		if (dormancy != nullptr)
+		{
+			for (int32 i = 0; i < Actors.Num(); ++i)
+			{
+				dormancy->WakeActor(Actors[i]);
+				if (Dormant)
+				{
+					dormancy->SleepActor(Actors[i]);
+				}
+			}
+			for (int32 i = 0; i < DormancyActors.Num(); ++i)
+			{
+				dormancy->WakeActor(DormancyActors[i]);
+				if (Dormant)
+				{
+					dormancy->SleepActor(DormancyActors[i]);
+				}
+			}
+		}
+	}
+
+	GAMEPLAY_EVENT(LogCyberShooterAggro, "Room shown", GetFName(), FColor::Cyan);
+}
+
+void AAggroZone::RoomHidden()
+{
+	// The room can be shown again before it unloads, dormant actors keep their state so RoomShown can resume them
+	UDormancySubsystem* dormancy = GetWorld()->GetSubsystem<UDormancySubsystem>();
+	if (dormancy != nullptr)
+	{
+		for (int32 i = 0; i < Actors.Num(); ++i)
+		{
+			dormancy->ReleaseActor(Actors[i]);
+		}
+		for (int32 i = 0; i < DormancyActors.Num(); ++i)
+		{
+			dormancy->ReleaseActor(DormancyActors[i]);
+		}
+	}
+
+	Actors.Empty();
+	DormancyActors.Empty();
+	ActorIndex.Empty();
+
+	GAMEPLAY_EVENT(LogCyberShooterAggro, "Room hidden", GetFName(), FColor::Cyan);
+}
+
+void AAggroZone::RoomUnloaded()
+{
+	UDormancySubsystem* dormancy = GetWorld()->GetSubsystem<UDormancySubsystem>();
+	if (dormancy != nullptr)
+	{
+		dormancy->ForgetUnloadedActors();
+	}
+}
+
+#if WITH_EDITOR
+void AAggroZone::PreSave(const ITargetPlatform* TargetPlatform)
+{
+	Super::PreSave(TargetPlatform);
+
+	// Only bake zones that are part of a level, streamed zones find their actors at runtime
+	if (!HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject) && GetWorld() != nullptr && RoomLevel.IsNull())
+	{
+		// The staleness check walks the zone's overlaps, only run it for interactive saves and not while cooking or in commandlets
+		if (TargetPlatform == nullptr && !IsRunningCommandlet() && IsActorListStale())
+		{
+			UE_LOG(LogCyberShooter, Warning, TEXT("Aggro zone %s has an out of date actor list, run Update Actor List"), *GetName());
+		}
+
+		BakeMembership();
+	}
+}
+
+void AAggroZone::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	if (PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(AAggroZone, Actors))
+	{
+		MembershipBaked = false;
+	}
+}
+
+void AAggroZone::BakeMembership()
+{
+	BakedEnemies = 0;
+	for (int32 i = 0; i < Actors.Num(); ++i)
+	{
+		IAggroInterface* object = Cast<IAggroInterface>(Actors[i]);
+		if (object != nullptr && object->BakeZone(this))
+		{
+			BakedEnemies++;
+		}
+	}
+
+	MembershipBaked = true;
+}
+
+bool AAggroZone::IsActorListStale() const
+{
+	if (!RoomLevel.IsNull())
+		return false;
+
+	TArray<AActor*> actors;
+	TArray<AActor*> dormancy_actors;
+	GatherActors(actors, dormancy_actors);
+
+	if (actors.Num() != Actors.Num())
+	{
+		return true;
+	}
+	for (int32 i = 0; i < actors.Num(); ++i)
+	{
+		if (!Actors.Contains(actors[i]))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+#endif
\ No newline at end of file
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "AggroInterface.h"
+#include "TimingWheelSubsystem.h"
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
@@ -20,6 +21,17 @@ public:
 	AAggroZone();
 
 	virtual void BeginPlay() override;
+	virtual void PostInitializeComponents() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+#if WITH_EDITOR
+	virtual void PreSave(const class ITargetPlatform* TargetPlatform) override;
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+
+	// Store zone membership in the zone's actors and cache the enemy count so BeginPlay can skip registration
+	void BakeMembership();
+	// Returns true if the saved actor list no longer matches the actors overlapping the zone
+	bool IsActorListStale() const;
+#endif
 
 	// Aggro enemies when the player enters the zone
 	UFUNCTION()
@@ -35,7 +47,12 @@ public:
 	// Notify the zone that an enemy has been registered
 	void NotifyRegister();
 	// Notify the zone that one of its actors has despawned
-	void NotifyDespawn();
+	void NotifyDespawn(AActor* Actor);
+
+	// Add a request to keep the zone's room level loaded
+	void RequestRoom();
+	// Remove a room request, the room unloads after RespawnTime once no requests remain
+	void ReleaseRoom();
 
 	// Force the zone to respawn
 	UFUNCTION(BlueprintCallable)
@@ -51,6 +68,24 @@ public:
 	UFUNCTION(BlueprintCallable)
 		void Deactivate();
 
+	// Restore the actors in the zone's dormancy set
+	void WakeZone();
+	// Suspend the actors in the zone's dormancy set
+	void SleepZone();
+
+	// Count the actors in the dormancy set that are ticking
+	int32 CountTickingActors() const;
+	// Returns true if an actor is controlled by this zone
+	bool ContainsActor(const AActor* Actor) const;
+
+	/// Accessors ///
+
+	FORCEINLINE bool IsDormant() const { return Dormant; }
+	FORCEINLINE bool IsMembershipBaked() const { return MembershipBaked; }
+	FORCEINLINE const TArray<AActor*>& GetActors() const { return Actors; }
+	FORCEINLINE int32 GetNumDormancyActors() const { return Actors.Num() + DormancyActors.Num(); }
+	FORCEINLINE bool IsStreamingRoom() const { return RoomStreamingLevel != nullptr; }
+
 	/// Blueprint Events ///
 
 	UPROPERTY(BlueprintAssignable, Category = "Events")
@@ -82,6 +117,16 @@ protected:
 	UPROPERTY(Category = "AI", EditAnywhere)
 		float RespawnTime;
 
+	// If set to true, the zone's actors will stop ticking, overlapping and rendering when the player is away from the zone
+	UPROPERTY(Category = "Dormancy", EditAnywhere)
+		bool UseDormancy;
+	// The time in seconds after the player leaves the zone before its actors go dormant
+	UPROPERTY(Category = "Dormancy", EditAnywhere)
+		float DormancyDelay;
+	// Actors that go dormant with the zone in addition to the actors it controls
+	UPROPERTY(Category = "Dormancy", EditInstanceOnly)
+		TArray<AActor*> DormancyActors;
+
 	// If set to false, the zone will not activate when the player enters it
 	UPROPERTY(Category = "Status", EditAnywhere, BlueprintReadOnly)
 		bool Active;
@@ -91,6 +136,9 @@ protected:
 	// Set to true when the player has activated the aggro zone
 	UPROPERTY(Category = "Status", EditAnywhere, BlueprintReadOnly)
 		bool Aggro;
+	// Set to true while the zone's actors are dormant
+	UPROPERTY(Category = "Status", VisibleAnywhere, BlueprintReadOnly)
+		bool Dormant;
 
 	// If set to true, the zone will change the camera distance when the player enters it
 	UPROPERTY(Category = "Camera", EditAnywhere)
@@ -99,6 +147,21 @@ protected:
 	UPROPERTY(Category = "Camera", EditAnywhere)
 		float CameraDistance;
 
+	// A streaming sublevel holding the zone's actors, loaded while the player is in this zone or an adjacent one
+	// Actors in the room can't be referenced from the zone, so the zone collects them each time the room is shown
+	UPROPERTY(Category = "Streaming", EditInstanceOnly)
+		TSoftObjectPtr<UWorld> RoomLevel;
+	// Zones whose rooms are loaded while the player is in this zone
+	UPROPERTY(Category = "Streaming", EditInstanceOnly)
+		TArray<AAggroZone*> AdjacentZones;
+
+	// Set when zone membership was baked as the level was saved
+	UPROPERTY(Category = "AI", VisibleAnywhere)
+		bool MembershipBaked;
+	// The number of enemies counted when zone membership was baked
+	UPROPERTY(Category = "AI", VisibleAnywhere)
+		int32 BakedEnemies;
+
 	// The number of enemies that this zone is tracking
 	UPROPERTY(EditAnywhere)
 		int32 TotalEnemies;
@@ -114,8 +177,44 @@ protected:
 	UPROPERTY(Category = "Sound", EditAnywhere)
 		USoundBase* ClearSound;
 
+	// Find the actors overlapping the zone that it should control
+	void GatherActors(TArray<AActor*>& OutActors, TArray<AActor*>& OutDormancyActors) const;
+	// Add an actor to the zone's controlled or dormancy actors if it belongs in either
+	void SortActor(AActor* Actor, TArray<AActor*>& OutActors, TArray<AActor*>& OutDormancyActors) const;
+	// Rebuild the lookup table for Actors
+	void RebuildActorIndex();
+
+	// Maps each actor in Actors to its aggro interface for constant time membership checks
+	TMap<AActor*, IAggroInterface*> ActorIndex;
+	// The aggro test drives the overlap handlers directly and checks the zone's status
+	friend class FAggroZoneAggroTest;
+
 	// The timer handle for enemy respawns
-	FTimerHandle TimerHandle_RespawnTimer;
+	FWheelTimerHandle TimerHandle_RespawnTimer;
+	// The timer handle for putting the zone to sleep
+	FWheelTimerHandle TimerHandle_DormancyTimer;
+
+	// Take control of the room's actors once its level is visible
+	UFUNCTION()
+		void RoomShown();
+	// Drop the room's actors after its level has been removed
+	UFUNCTION()
+		void RoomHidden();
+	// Forget the dormancy state of the room's actors once its level has unloaded
+	UFUNCTION()
+		void RoomUnloaded();
+	// Unload the room level if nothing has requested it since the timer started
+	void UnloadRoom();
+
+	// The streaming level for RoomLevel, null if the zone doesn't stream its actors
+	UPROPERTY()
+		class ULevelStreaming* RoomStreamingLevel;
+	// The number of occupied zones that need the room loaded
+	int32 RoomRequests;
+	// Names of room actors that despawned since the zone last respawned, so they stay out of play when the room is reloaded
+	TSet<FName> DespawnedActors;
+	// The timer handle for unloading the room
+	FWheelTimerHandle TimerHandle_UnloadTimer;
 
 #if WITH_EDITORONLY_DATA
 	// Arrow indicating the orientation of the zone
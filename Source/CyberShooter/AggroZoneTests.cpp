@@ -0,0 +1,104 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#include "AggroZone.h"
+#include "CyberShooterEnemy.h"
+#include "CyberShooterPlayer.h"
+#include "Spawner.h"
+#include "TimingWheelSubsystem.h"
+#include "CyberShooter.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FAggroZoneAggroTest, "CyberShooter.AggroZone.Aggro", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FAggroZoneAggroTest::RunTest(const FString& Parameters)
+{
+	UWorld* world = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& context = GEngine->CreateNewWorldContext(EWorldType::Game);
+	context.SetCurrentWorld(world);
+	UTimingWheelSubsystem* timers = world->GetSubsystem<UTimingWheelSubsystem>();
+
+	// A zone holding an enemy and a spawner, with another enemy and spawner outside it
+	AAggroZone* zone = world->SpawnActor<AAggroZone>();
+	AEnemyTurret* inside_enemy = world->SpawnActor<AEnemyTurret>();
+	AEnemyTurret* outside_enemy = world->SpawnActor<AEnemyTurret>();
+	ASpawner* inside_spawner = world->SpawnActor<ASpawner>();
+	ASpawner* outside_spawner = world->SpawnActor<ASpawner>();
+	ACyberShooterPlayer* player = world->SpawnActor<ACyberShooterPlayer>();
+
+	// Minions of each spawner
+	AEnemyMinion* inside_minion = world->SpawnActor<AEnemyMinion>();
+	AEnemyMinion* outside_minion = world->SpawnActor<AEnemyMinion>();
+	inside_minion->ClaimPawn(inside_spawner);
+	outside_minion->ClaimPawn(outside_spawner);
+
+	// Keep the zone from touching the player's camera or putting its actors to sleep
+	zone->RestrictOrientation = false;
+	zone->SetCamera = false;
+	zone->UseDormancy = false;
+	zone->Actors.Add(inside_enemy);
+	zone->Actors.Add(nullptr);
+	zone->Actors.Add(inside_spawner);
+	zone->RebuildActorIndex();
+	inside_spawner->RegisterZone(zone);
+
+	TestTrue(TEXT("Zone controls the enemy inside it"), zone->ContainsActor(inside_enemy));
+	TestFalse(TEXT("Zone doesn't control the enemy outside it"), zone->ContainsActor(outside_enemy));
+	TestTrue(TEXT("Minion of a spawner in the zone belongs to the zone"), inside_minion->IsInZone(zone));
+	TestFalse(TEXT("Minion of a spawner outside the zone doesn't belong to the zone"), outside_minion->IsInZone(zone));
+
+	// The player entering the zone aggroes the actors it controls
+	zone->BeginOverlap(zone, player);
+	TestTrue(TEXT("Zone is aggroed after the player enters"), zone->Aggro);
+	TestTrue(TEXT("Enemy in the zone aggroes when the player enters"), inside_enemy->IsAggro());
+	TestFalse(TEXT("Enemy outside the zone ignores the player entering"), outside_enemy->IsAggro());
+	TestEqual(TEXT("Spawner in the zone aggroes when the player enters"), inside_spawner->GetAggro(), 1);
+	TestEqual(TEXT("Spawner outside the zone ignores the player entering"), outside_spawner->GetAggro(), 0);
+
+	// Other actors entering the zone don't aggro it
+	zone->BeginOverlap(zone, outside_enemy);
+	TestTrue(TEXT("Enemy in the zone is aggroed once"), inside_enemy->IsAggro());
+	TestEqual(TEXT("Spawner in the zone is aggroed once"), inside_spawner->GetAggro(), 1);
+
+	// The player leaving the zone deaggroes its actors and starts the respawn timer
+	zone->EndOverlap(zone, player);
+	TestFalse(TEXT("Zone is not aggroed after the player leaves"), zone->Aggro);
+	TestFalse(TEXT("Enemy in the zone deaggroes when the player leaves"), inside_enemy->IsAggro());
+	TestEqual(TEXT("Spawner in the zone deaggroes when the player leaves"), inside_spawner->GetAggro(), 0);
+	TestTrue(TEXT("Respawn timer starts when the player leaves"), timers != nullptr && timers->IsTimerActive(zone->TimerHandle_RespawnTimer));
+
+	// Returning before the respawn cancels it
+	zone->BeginOverlap(zone, player);
+	TestTrue(TEXT("Enemy in the zone aggroes when the player returns"), inside_enemy->IsAggro());
+	TestFalse(TEXT("Respawn timer is cancelled when the player returns"), timers != nullptr && timers->IsTimerActive(zone->TimerHandle_RespawnTimer));
+	zone->EndOverlap(zone, player);
+
+	// An inactive zone ignores the player
+	zone->Active = false;
+	zone->BeginOverlap(zone, player);
+	TestFalse(TEXT("Inactive zone doesn't aggro"), zone->Aggro);
+	TestFalse(TEXT("Enemy in an inactive zone doesn't aggro"), inside_enemy->IsAggro());
+	zone->EndOverlap(zone, player);
+	TestEqual(TEXT("Leaving an inactive zone doesn't deaggro its actors"), inside_spawner->GetAggro(), 0);
+
+	// Actors replaced in the list are picked up by the next rebuild
+	zone->Active = true;
+	zone->Actors.Remove(inside_enemy);
+	zone->Actors.Add(outside_enemy);
+	zone->RebuildActorIndex();
+	zone->BeginOverlap(zone, player);
+	TestFalse(TEXT("Removed enemy doesn't aggro"), inside_enemy->IsAggro());
+	TestTrue(TEXT("Added enemy aggroes"), outside_enemy->IsAggro());
+	zone->EndOverlap(zone, player);
+
+	GEngine->DestroyWorldContext(world);
+	world->DestroyWorld(false);
+
+	return true;
+}
+
+#endif
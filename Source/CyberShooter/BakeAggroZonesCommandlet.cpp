@@ -0,0 +1,87 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#include "BakeAggroZonesCommandlet.h"
+#include "AggroZone.h"
+#include "CyberShooter.h"
+
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/FileManager.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+UBakeAggroZonesCommandlet::UBakeAggroZonesCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UBakeAggroZonesCommandlet::Main(const FString& Params)
+{
+#if WITH_EDITOR
+	TArray<FString> tokens;
+	TArray<FString> switches;
+	ParseCommandLine(*Params, tokens, switches);
+	const bool save = switches.Contains(TEXT("save"));
+
+	// Find every map in the project
+	TArray<FString> map_files;
+	IFileManager::Get().FindFilesRecursive(map_files, *FPaths::ProjectContentDir(), *(FString("*") + FPackageName::GetMapPackageExtension()), true, false);
+
+	int32 stale_zones = 0;
+	for (const FString& file : map_files)
+	{
+		const FString package_name = FPackageName::FilenameToLongPackageName(file);
+		UPackage* package = LoadPackage(nullptr, *package_name, LOAD_None);
+		UWorld* world = package != nullptr ? UWorld::FindWorldInPackage(package) : nullptr;
+		if (world == nullptr)
+		{
+			UE_LOG(LogCyberShooter, Warning, TEXT("Unable to load %s"), *package_name);
+			continue;
+		}
+
+		// Initialize the world so zones can run overlap queries
+		world->WorldType = EWorldType::Editor;
+		world->AddToRoot();
+		if (!world->bIsWorldInitialized)
+		{
+			world->InitWorld(UWorld::InitializationValues().ShouldSimulatePhysics(false).EnableTraceCollision(true).CreateNavigation(false).CreateAISystem(false).AllowAudioPlayback(false));
+		}
+		world->UpdateWorldComponents(true, false);
+
+		int32 zones = 0;
+		for (TActorIterator<AAggroZone> it(world); it; ++it)
+		{
+			zones++;
+			if (it->IsActorListStale())
+			{
+				UE_LOG(LogCyberShooter, Warning, TEXT("%s: aggro zone %s has an out of date actor list"), *package_name, *it->GetName());
+				stale_zones++;
+			}
+		}
+
+		// Saving runs PreSave on every zone, which bakes zone membership into the zone's own data
+		if (save && zones > 0)
+		{
+			package->MarkPackageDirty();
+			if (!UPackage::SavePackage(package, world, RF_Standalone, *file, GError, nullptr, false, true, SAVE_NoError))
+			{
+				UE_LOG(LogCyberShooter, Error, TEXT("Unable to save %s"), *package_name);
+			}
+		}
+
+		world->DestroyWorld(false);
+		world->RemoveFromRoot();
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	}
+
+	UE_LOG(LogCyberShooter, Display, TEXT("Checked %d maps, found %d stale aggro zones"), map_files.Num(), stale_zones);
+
+	return stale_zones > 0 ? 1 : 0;
+#else
+	return 0;
+#endif
+}
@@ -0,0 +1,20 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BakeAggroZonesCommandlet.generated.h"
+
+// Reports aggro zones with out of date actor lists and resaves maps to bake zone membership
+// Usage: UE4Editor-Cmd.exe CyberShooter.uproject -run=BakeAggroZones [-save]
+UCLASS()
+class CYBERSHOOTER_API UBakeAggroZonesCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UBakeAggroZonesCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -1,6 +1,9 @@
 // Copyright © 2020 Brian Faubion. All rights reserved.
 
 #include "BulletMovementComponent.h"
+#include "BulletSubsystem.h"
+
+#include "Engine/World.h"
 
 UBulletMovementComponent::UBulletMovementComponent()
 {
@@ -20,6 +23,34 @@ UBulletMovementComponent::UBulletMovementComponent()
 	AirFriction = 0.5f;
 	TickSpeed = 1.0f;
 	Acceleration = 0.0f;
+
+	BatchIndex = INDEX_NONE;
+}
+
+void UBulletMovementComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Hand simple bullets over to the bullet subsystem
+	if (CanBatchMovement())
+	{
+		UBulletSubsystem* subsystem = GetWorld()->GetSubsystem<UBulletSubsystem>();
+		if (subsystem != nullptr)
+		{
+			subsystem->RegisterBullet(this);
+		}
+	}
+}
+
+void UBulletMovementComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UBulletSubsystem* subsystem = GetWorld()->GetSubsystem<UBulletSubsystem>();
+	if (subsystem != nullptr)
+	{
+		subsystem->UnregisterBullet(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void UBulletMovementComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
@@ -39,6 +70,79 @@ void UBulletMovementComponent::TickComponent(float DeltaTime, enum ELevelTick Ti
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 }
 
+void UBulletMovementComponent::SweepBullet(float DeltaTime)
+{
+	// Bullets with nothing to move are finished
+	if (!bSimulationEnabled || HasStoppedSimulation() || !IsValid(UpdatedComponent) || ShouldSkipUpdate(DeltaTime))
+	{
+		return;
+	}
+
+	// Destroy bullets that have left the world or fallen below the kill Z, as the projectile tick does
+	if (!CheckStillInWorld())
+	{
+		return;
+	}
+
+	float remaining_time = DeltaTime;
+	uint32 bounces = 0;
+	int32 iterations = 0;
+
+	while (remaining_time >= 1.0e-6f && iterations < MaxSimulationIterations && IsValid(UpdatedComponent) && !HasStoppedSimulation())
+	{
+		// Substep the same way the projectile tick does, batched bullets normally take the whole frame in one step
+		iterations++;
+		const float time_tick = ShouldUseSubStepping() ? GetSimulationTimeStep(remaining_time, iterations) : remaining_time;
+		remaining_time -= time_tick;
+
+		// Sweep along the current velocity
+		const FVector old_velocity = Velocity;
+		const FVector move_delta = ConstrainDirectionToPlane(Velocity * time_tick);
+		const FQuat rotation = (bRotationFollowsVelocity && !Velocity.IsNearlyZero()) ? Velocity.ToOrientationQuat() : UpdatedComponent->GetComponentQuat();
+
+		FHitResult hit(1.0f);
+		SafeMoveUpdatedComponent(move_delta, rotation, bSweepCollision, hit);
+
+		// Hit events may have destroyed the bullet
+		if (HasStoppedSimulation() || !IsValid(UpdatedComponent))
+		{
+			break;
+		}
+
+		if (!hit.bBlockingHit)
+		{
+			PreviousHitTime = 1.0f;
+			bIsSliding = false;
+		}
+		else
+		{
+			// Bounce or stop based on the projectile settings
+			float sub_time = time_tick * (1.0f - hit.Time);
+			const EHandleBlockingHitResult result = HandleBlockingHit(hit, time_tick, move_delta, sub_time);
+			if (result == EHandleBlockingHitResult::Abort || HasStoppedSimulation())
+			{
+				break;
+			}
+			else if (result == EHandleBlockingHitResult::Deflect)
+			{
+				bounces++;
+				HandleDeflection(hit, old_velocity, bounces, sub_time);
+				PreviousHitTime = hit.Time;
+				PreviousHitNormal = ConstrainNormalToPlane(hit.Normal);
+			}
+
+			remaining_time += sub_time;
+		}
+	}
+
+	UpdateComponentVelocity();
+}
+
+bool UBulletMovementComponent::CanBatchMovement() const
+{
+	return UBulletSubsystem::IsBatchingEnabled() && !bIsHomingProjectile && ProjectileGravityScale == 0.0f && !bForceSubStepping;
+}
+
 void UBulletMovementComponent::AddVelocity(FVector VelocityImpulse)
 {
 	Velocity += VelocityImpulse;
@@ -15,8 +15,15 @@ class CYBERSHOOTER_API UBulletMovementComponent : public UProjectileMovementComp
 public:
 	UBulletMovementComponent();
 
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
+	// Move the bullet along its current velocity, handling bounces and impacts
+	void SweepBullet(float DeltaTime);
+	// Returns true if the bullet's movement is simple enough to be batched by the bullet subsystem
+	bool CanBatchMovement() const;
+
 	// Add velocity to the bullet
 	void AddVelocity(FVector VelocityImpulse);
 
@@ -28,6 +35,8 @@ public:
 	void SetAirFriction(float NewFriction);
 
 protected:
+	friend class UBulletSubsystem;
+
 	// Static forces applied to the bullet
 	UPROPERTY(Category = "Physics", VisibleAnywhere)
 		FVector StaticForce;
@@ -40,4 +49,7 @@ protected:
 	// The acceleration of the projectile
 	UPROPERTY(Category = "Projectile", EditDefaultsOnly)
 		float Acceleration;
+
+	// The bullet's position in the bullet subsystem's batch, or INDEX_NONE if it isn't batched
+	int32 BatchIndex;
 };
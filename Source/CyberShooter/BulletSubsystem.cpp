@@ -0,0 +1,306 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#include "BulletSubsystem.h"
+#include "BulletMovementComponent.h"
+#include "CyberShooterProjectile.h"
+#include "CyberShooter.h"
+
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+DECLARE_CYCLE_STAT(TEXT("Bullet Integration"), STAT_BulletIntegration, STATGROUP_CyberShooter);
+DECLARE_CYCLE_STAT(TEXT("Bullet Sweeps"), STAT_BulletSweeps, STATGROUP_CyberShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Batched Bullets"), STAT_BatchedBullets, STATGROUP_CyberShooter);
+
+static TAutoConsoleVariable<int32> CVarBatchBullets(
+	TEXT("cs.BatchBullets"),
+	1,
+	TEXT("Integrate simple bullets in a single batch instead of ticking each movement component.\n")
+	TEXT("0: Use the per-component projectile tick\n")
+	TEXT("1: Batch bullets with no homing or gravity"),
+	ECVF_Default);
+
+static FAutoConsoleCommandWithWorldAndArgs BulletBenchmarkCommand(
+	TEXT("cs.BulletBenchmark"),
+	TEXT("Time moving projectiles with the per-component projectile tick and with the bullet batch, and time registering and unregistering batched bullets. Takes optional bullet counts, defaulting to 1000 and 10000."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UBulletSubsystem* subsystem = World->GetSubsystem<UBulletSubsystem>();
+		if (subsystem == nullptr)
+			return;
+
+		TArray<int32> counts;
+		for (const FString& arg : Args)
+		{
+			counts.Add(FMath::Max(FCString::Atoi(*arg), 1));
+		}
+		if (counts.Num() == 0)
+		{
+			counts.Add(1000);
+			counts.Add(10000);
+		}
+
+		const int32 passes = 30;
+		const float delta_time = 1.0f / 60.0f;
+		for (const int32 count : counts)
+		{
+			// Spawn real projectiles on a grid high above the level, all flying the same way so they sweep without hitting each other
+			const int32 columns = FMath::CeilToInt(FMath::Sqrt((float)count));
+			FActorSpawnParameters params;
+			params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+			TArray<ACyberShooterProjectile*> projectiles;
+			TArray<UBulletMovementComponent*> bullets;
+			for (int32 i = 0; i < count; ++i)
+			{
+				const FVector location(0.0f, (i % columns) * 50.0f, 50000.0f + (i / columns) * 50.0f);
+				ACyberShooterProjectile* projectile = World->SpawnActor<ACyberShooterProjectile>(location, FRotator::ZeroRotator, params);
+				if (projectile != nullptr)
+				{
+					projectiles.Add(projectile);
+					bullets.Add(projectile->GetProjectileMovement());
+				}
+			}
+
+			// The stock path ticks each projectile movement component on its own
+			for (UBulletMovementComponent* bullet : bullets)
+			{
+				subsystem->UnregisterBullet(bullet);
+				bullet->SetComponentTickEnabled(false);
+			}
+			double start = FPlatformTime::Seconds();
+			for (int32 pass = 0; pass < passes; ++pass)
+			{
+				for (UBulletMovementComponent* bullet : bullets)
+				{
+					bullet->TickComponent(delta_time, LEVELTICK_All, &bullet->PrimaryComponentTick);
+				}
+			}
+			const double stock_time = (FPlatformTime::Seconds() - start) / passes;
+
+			start = FPlatformTime::Seconds();
+			for (UBulletMovementComponent* bullet : bullets)
+			{
+				subsystem->RegisterBullet(bullet);
+			}
+			const double register_time = FPlatformTime::Seconds() - start;
+
+			start = FPlatformTime::Seconds();
+			for (int32 pass = 0; pass < passes; ++pass)
+			{
+				subsystem->Tick(delta_time);
+			}
+			const double batch_time = (FPlatformTime::Seconds() - start) / passes;
+
+			// Remove in a shuffled order so bullets come out of the middle of the batch like they do in play
+			FRandomStream stream(count);
+			for (int32 i = bullets.Num() - 1; i > 0; --i)
+			{
+				bullets.Swap(i, stream.RandRange(0, i));
+			}
+			start = FPlatformTime::Seconds();
+			for (UBulletMovementComponent* bullet : bullets)
+			{
+				subsystem->UnregisterBullet(bullet);
+			}
+			const double unregister_time = FPlatformTime::Seconds() - start;
+
+			for (ACyberShooterProjectile* projectile : projectiles)
+			{
+				projectile->Destroy();
+			}
+
+			UE_LOG(LogCyberShooter, Log, TEXT("%d bullets: per-component tick %.3f ms, batch %.3f ms, register %.3f ms, unregister %.3f ms"), bullets.Num(), stock_time * 1000.0, batch_time * 1000.0, register_time * 1000.0, unregister_time * 1000.0);
+		}
+	}));
+
+UBulletSubsystem::UBulletSubsystem()
+{
+	Updating = false;
+	PendingCompact = false;
+}
+
+void UBulletSubsystem::Deinitialize()
+{
+	Bullets.Empty();
+
+	Super::Deinitialize();
+}
+
+/// FTickableGameObject ///
+
+void UBulletSubsystem::Tick(float DeltaTime)
+{
+	const int32 count = Bullets.Num();
+	SET_DWORD_STAT(STAT_BatchedBullets, count);
+
+	// Gather the state of each bullet into packed arrays
+	VelocityX.SetNumUninitialized(count, false);
+	VelocityY.SetNumUninitialized(count, false);
+	VelocityZ.SetNumUninitialized(count, false);
+	ForceX.SetNumUninitialized(count, false);
+	ForceY.SetNumUninitialized(count, false);
+	ForceZ.SetNumUninitialized(count, false);
+	Acceleration.SetNumUninitialized(count, false);
+	MaxSpeed.SetNumUninitialized(count, false);
+	TimeStep.SetNumUninitialized(count, false);
+
+	for (int32 i = 0; i < count; ++i)
+	{
+		const UBulletMovementComponent* bullet = Bullets[i];
+		const FVector force = bullet->StaticForce / bullet->AirFriction;
+
+		VelocityX[i] = bullet->Velocity.X;
+		VelocityY[i] = bullet->Velocity.Y;
+		VelocityZ[i] = bullet->Velocity.Z;
+		ForceX[i] = force.X;
+		ForceY[i] = force.Y;
+		ForceZ[i] = force.Z;
+		Acceleration[i] = bullet->Acceleration;
+		MaxSpeed[i] = bullet->GetMaxSpeed();
+		// Inactive bullets get a zero time step so they stay where they are
+		TimeStep[i] = bullet->IsActive() ? DeltaTime * bullet->TickSpeed : 0.0f;
+	}
+
+	IntegrateVelocities(count);
+
+	// Move each bullet along its new velocity
+	{
+		SCOPE_CYCLE_COUNTER(STAT_BulletSweeps);
+
+		Updating = true;
+		for (int32 i = 0; i < count; ++i)
+		{
+			UBulletMovementComponent* bullet = Bullets[i];
+			if (bullet != nullptr && bullet->IsActive())
+			{
+				bullet->Velocity = FVector(VelocityX[i], VelocityY[i], VelocityZ[i]);
+				bullet->SweepBullet(TimeStep[i]);
+			}
+		}
+		Updating = false;
+	}
+
+	if (PendingCompact)
+	{
+		CompactBullets();
+	}
+}
+
+ETickableTickType UBulletSubsystem::GetTickableTickType() const
+{
+	// Don't tick the class default object
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UBulletSubsystem::IsTickable() const
+{
+	return Bullets.Num() > 0;
+}
+
+TStatId UBulletSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBulletSubsystem, STATGROUP_Tickables);
+}
+
+UWorld* UBulletSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+/// Bullet Functions ///
+
+void UBulletSubsystem::RegisterBullet(UBulletMovementComponent* Bullet)
+{
+	if (Bullet != nullptr && Bullet->BatchIndex == INDEX_NONE)
+	{
+		Bullet->BatchIndex = Bullets.Add(Bullet);
+
+		// Keep the movement component from re-registering its own tick
+		Bullet->bAutoUpdateTickRegistration = false;
+		Bullet->SetComponentTickEnabled(false);
+	}
+}
+
+void UBulletSubsystem::UnregisterBullet(UBulletMovementComponent* Bullet)
+{
+	if (Bullet == nullptr || !Bullets.IsValidIndex(Bullet->BatchIndex) || Bullets[Bullet->BatchIndex] != Bullet)
+		return;
+
+	const int32 index = Bullet->BatchIndex;
+	Bullet->BatchIndex = INDEX_NONE;
+
+	if (Updating)
+	{
+		// Bullets destroyed by their own hit events are removed after the sweep loop
+		Bullets[index] = nullptr;
+		PendingCompact = true;
+	}
+	else
+	{
+		// Swap the last bullet into the removed bullet's place
+		Bullets.RemoveAtSwap(index, 1, false);
+		if (index < Bullets.Num())
+		{
+			Bullets[index]->BatchIndex = index;
+		}
+	}
+}
+
+bool UBulletSubsystem::IsBatchingEnabled()
+{
+	return CVarBatchBullets.GetValueOnGameThread() != 0;
+}
+
+void UBulletSubsystem::IntegrateVelocities(int32 Count)
+{
+	SCOPE_CYCLE_COUNTER(STAT_BulletIntegration);
+
+	float* RESTRICT vx = VelocityX.GetData();
+	float* RESTRICT vy = VelocityY.GetData();
+	float* RESTRICT vz = VelocityZ.GetData();
+	const float* RESTRICT fx = ForceX.GetData();
+	const float* RESTRICT fy = ForceY.GetData();
+	const float* RESTRICT fz = ForceZ.GetData();
+	const float* RESTRICT accel = Acceleration.GetData();
+	const float* RESTRICT max_speed = MaxSpeed.GetData();
+	const float* RESTRICT dt = TimeStep.GetData();
+
+	// Apply static forces
+	for (int32 i = 0; i < Count; ++i)
+	{
+		vx[i] += fx[i] * dt[i];
+		vy[i] += fy[i] * dt[i];
+		vz[i] += fz[i] * dt[i];
+	}
+
+	// Apply acceleration along the direction of travel and clamp to the max speed
+	for (int32 i = 0; i < Count; ++i)
+	{
+		const float size_squared = vx[i] * vx[i] + vy[i] * vy[i] + vz[i] * vz[i];
+		const float size = FMath::Sqrt(size_squared);
+		const float inverse_size = size_squared > SMALL_NUMBER ? 1.0f / size : 0.0f;
+
+		float new_size = size + (accel[i] > 0.0f ? accel[i] * dt[i] : 0.0f);
+		new_size = max_speed[i] > 0.0f ? FMath::Min(new_size, max_speed[i]) : new_size;
+
+		const float scale = new_size * inverse_size + (size_squared > SMALL_NUMBER ? 0.0f : 1.0f);
+		vx[i] *= scale;
+		vy[i] *= scale;
+		vz[i] *= scale;
+	}
+}
+
+void UBulletSubsystem::CompactBullets()
+{
+	Bullets.RemoveAllSwap([](const UBulletMovementComponent* Bullet) { return Bullet == nullptr; }, false);
+	PendingCompact = false;
+
+	// Swapped bullets have moved, so refresh every index
+	for (int32 i = 0; i < Bullets.Num(); ++i)
+	{
+		Bullets[i]->BatchIndex = i;
+	}
+}
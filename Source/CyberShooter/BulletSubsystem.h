@@ -0,0 +1,68 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "BulletSubsystem.generated.h"
+
+class UBulletMovementComponent;
+
+// Integrates every simple bullet in the world in one pass instead of ticking each movement component
+UCLASS()
+class CYBERSHOOTER_API UBulletSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UBulletSubsystem();
+
+	virtual void Deinitialize() override;
+
+	/// FTickableGameObject ///
+
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	/// Bullet Functions ///
+
+	// Add a bullet to the batch, disabling its component tick
+	void RegisterBullet(UBulletMovementComponent* Bullet);
+	// Remove a bullet from the batch
+	void UnregisterBullet(UBulletMovementComponent* Bullet);
+
+	// Returns true if bullets should be batched by the subsystem
+	static bool IsBatchingEnabled();
+
+	FORCEINLINE int32 GetNumBullets() const { return Bullets.Num(); }
+
+protected:
+	// Advance the packed velocities of every bullet
+	void IntegrateVelocities(int32 Count);
+	// Remove bullets that were unregistered during the update
+	void CompactBullets();
+
+	// The bullets currently managed by the subsystem
+	UPROPERTY()
+		TArray<UBulletMovementComponent*> Bullets;
+
+	// Packed bullet state, rebuilt each frame
+	TArray<float> VelocityX;
+	TArray<float> VelocityY;
+	TArray<float> VelocityZ;
+	TArray<float> ForceX;
+	TArray<float> ForceY;
+	TArray<float> ForceZ;
+	TArray<float> Acceleration;
+	TArray<float> MaxSpeed;
+	TArray<float> TimeStep;
+
+	// Set while bullets are being swept so removals can be deferred
+	bool Updating;
+	// Set when a bullet was removed during the update
+	bool PendingCompact;
+};
@@ -3,6 +3,7 @@
 #include "CheckpointTrigger.h"
 #include "CyberShooterGameInstance.h"
 #include "CyberShooterPlayer.h"
+#include "ActorRegistrySubsystem.h"
 
 #if WITH_EDITOR
 #include "Components/ArrowComponent.h"
@@ -30,6 +31,29 @@ ACheckpointTrigger::ACheckpointTrigger()
 #endif
 }
 
+void ACheckpointTrigger::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// Add the actor to the world's registry
+	UActorRegistrySubsystem* registry = GetWorld()->GetSubsystem<UActorRegistrySubsystem>();
+	if (registry != nullptr)
+	{
+		registry->Register(this);
+	}
+}
+
+void ACheckpointTrigger::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UActorRegistrySubsystem* registry = GetWorld()->GetSubsystem<UActorRegistrySubsystem>();
+	if (registry != nullptr)
+	{
+		registry->Unregister(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void ACheckpointTrigger::BeginOverlap(AActor* OverlappedActor, AActor* OtherActor)
 {
 	// Save the game and refill stats if the player overlaps the trigger
@@ -15,6 +15,8 @@ class CYBERSHOOTER_API ACheckpointTrigger : public AActor
 public:	
 	ACheckpointTrigger();
 
+	virtual void PostInitializeComponents() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 protected:
 	// Save the game when the player overlaps the trigger
 	UFUNCTION()
@@ -52,4 +52,7 @@ public:
 	// Called when the object is killed
 	UFUNCTION()
 		virtual void Kill() = 0;
+
+	// Get the world time in seconds until the object can be damaged again, used to schedule continuous damage
+	virtual float GetDamageCooldown() const { return 0.0f; }
 };
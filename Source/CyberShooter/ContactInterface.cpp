@@ -0,0 +1,5 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#include "ContactInterface.h"
+
+// Add default functionality here for any IContactInterface functions that are not pure virtual.
@@ -0,0 +1,26 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "ContactInterface.generated.h"
+
+// This class does not need to be modified.
+UINTERFACE(MinimalAPI)
+class UContactInterface : public UInterface
+{
+	GENERATED_BODY()
+};
+
+// An interface for actors that resolve their blocking hits through the contact cache
+class CYBERSHOOTER_API IContactInterface
+{
+	GENERATED_BODY()
+
+public:
+	// Called once per frame for each component pair this actor collided with, using the merged impact normal
+	// Only one side of a pair is called, so the handler applies the contact's effects to both actors
+	// The velocities are from when the contact was first reported, before either side slid along the hit
+	virtual void ResolveContact(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector Normal, FVector Velocity, FVector OtherVelocity) = 0;
+};
@@ -0,0 +1,142 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#include "ContactSubsystem.h"
+#include "ContactInterface.h"
+#include "PhysicsInterface.h"
+#include "CyberShooter.h"
+
+#include "Components/PrimitiveComponent.h"
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Contact Resolution"), STAT_ContactResolution, STATGROUP_CyberShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Raw Contacts"), STAT_RawContacts, STATGROUP_CyberShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Unique Contacts"), STAT_UniqueContacts, STATGROUP_CyberShooter);
+
+// Get the velocity an actor is moving with, using the physics velocity when the actor has one
+static FVector GetContactVelocity(AActor* Actor)
+{
+	IPhysicsInterface* physics = Cast<IPhysicsInterface>(Actor);
+	return physics != nullptr ? physics->GetVelocity() : Actor->GetVelocity();
+}
+
+UContactSubsystem::UContactSubsystem()
+{
+	RawContacts = 0;
+	LastRawContacts = 0;
+	LastUniqueContacts = 0;
+}
+
+void UContactSubsystem::Deinitialize()
+{
+	Contacts.Empty();
+	ContactIndex.Empty();
+
+	Super::Deinitialize();
+}
+
+/// FTickableGameObject ///
+
+void UContactSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ContactResolution);
+
+	LastRawContacts = RawContacts;
+	LastUniqueContacts = Contacts.Num();
+	SET_DWORD_STAT(STAT_RawContacts, LastRawContacts);
+	SET_DWORD_STAT(STAT_UniqueContacts, LastUniqueContacts);
+
+	// Take the gathered contacts so anything reported during resolution waits for the next frame
+	TArray<FContactRecord> resolving = MoveTemp(Contacts);
+	Contacts.Reset();
+	ContactIndex.Reset();
+	RawContacts = 0;
+
+	for (const FContactRecord& contact : resolving)
+	{
+		const FVector normal = contact.Normal.GetSafeNormal();
+
+		// Either side may have been destroyed by an earlier contact's handler
+		AActor* actor = contact.Actor.Get();
+		AActor* other = contact.OtherActor.Get();
+		if (actor == nullptr || other == nullptr || actor->IsPendingKill() || other->IsPendingKill())
+			continue;
+
+		// Resolve the pair once, from the other side if only it was moving into the contact
+		IContactInterface* handler = Cast<IContactInterface>(actor);
+		IContactInterface* other_handler = Cast<IContactInterface>(other);
+		const bool other_approaching = FVector::DotProduct(contact.Velocity, normal) >= 0.0f && FVector::DotProduct(contact.OtherVelocity, normal) > 0.0f;
+		if (other_handler != nullptr && (handler == nullptr || other_approaching))
+		{
+			other_handler->ResolveContact(contact.OtherComponent.Get(), actor, contact.Component.Get(), -normal, contact.OtherVelocity, contact.Velocity);
+		}
+		else if (handler != nullptr)
+		{
+			handler->ResolveContact(contact.Component.Get(), other, contact.OtherComponent.Get(), normal, contact.Velocity, contact.OtherVelocity);
+		}
+	}
+}
+
+ETickableTickType UContactSubsystem::GetTickableTickType() const
+{
+	// Don't tick the class default object
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Always;
+}
+
+bool UContactSubsystem::IsTickable() const
+{
+	return true;
+}
+
+TStatId UContactSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UContactSubsystem, STATGROUP_Tickables);
+}
+
+UWorld* UContactSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+/// Contact Functions ///
+
+void UContactSubsystem::ReportHit(AActor* Actor, UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, const FHitResult& Hit)
+{
+	// Walls and other static geometry are handled by the movement components
+	if (OtherActor != nullptr && OtherActor != Actor && Cast<IPhysicsInterface>(OtherActor) != nullptr)
+	{
+		UContactSubsystem* contacts = Actor->GetWorld()->GetSubsystem<UContactSubsystem>();
+		if (contacts != nullptr)
+		{
+			contacts->AddContact(Actor, HitComp, OtherActor, OtherComp, Hit.Normal);
+		}
+	}
+}
+
+void UContactSubsystem::AddContact(AActor* Actor, UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector Normal)
+{
+	RawContacts++;
+
+	// Order the pair so both sides of a contact share a key
+	const TPair<const UPrimitiveComponent*, const UPrimitiveComponent*> key = HitComp < OtherComp ? MakeTuple((const UPrimitiveComponent*)HitComp, (const UPrimitiveComponent*)OtherComp) : MakeTuple((const UPrimitiveComponent*)OtherComp, (const UPrimitiveComponent*)HitComp);
+
+	const int32* index = ContactIndex.Find(key);
+	if (index != nullptr)
+	{
+		// Merge the normal, flipping it if the other side of the contact reported the hit
+		FContactRecord& contact = Contacts[*index];
+		contact.Normal += contact.Component.Get() == HitComp ? Normal : -Normal;
+	}
+	else
+	{
+		FContactRecord contact;
+		contact.Actor = Actor;
+		contact.Component = HitComp;
+		contact.OtherActor = OtherActor;
+		contact.OtherComponent = OtherComp;
+		contact.Normal = Normal;
+		contact.Velocity = GetContactVelocity(Actor);
+		contact.OtherVelocity = GetContactVelocity(OtherActor);
+
+		ContactIndex.Add(key, Contacts.Add(contact));
+	}
+}
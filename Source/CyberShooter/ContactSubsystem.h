@@ -0,0 +1,68 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ContactSubsystem.generated.h"
+
+// A contact between two components gathered during the current frame
+struct FContactRecord
+{
+	// The actor that first reported the contact
+	TWeakObjectPtr<AActor> Actor;
+	TWeakObjectPtr<UPrimitiveComponent> Component;
+	// The other side of the contact
+	TWeakObjectPtr<AActor> OtherActor;
+	TWeakObjectPtr<UPrimitiveComponent> OtherComponent;
+	// The sum of all reported normals, pointing from the other component towards Component
+	FVector Normal;
+	// The velocity of each side when the contact was first reported, before the movement components slid along the hit
+	FVector Velocity;
+	FVector OtherVelocity;
+};
+
+// Collects blocking hits between pawns and physics objects so each component pair is resolved once per frame
+// Each pair is handed to one side's handler, preferring the side that was moving into the contact so its impact check sees it as the cause
+UCLASS()
+class CYBERSHOOTER_API UContactSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UContactSubsystem();
+
+	virtual void Deinitialize() override;
+
+	/// FTickableGameObject ///
+
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	/// Contact Functions ///
+
+	// Queue a blocking hit from an actor's OnComponentHit event if the other actor takes part in physics contacts
+	static void ReportHit(AActor* Actor, UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, const FHitResult& Hit);
+
+	// Record a blocking hit reported by an actor's hit event, merging it with any contact already recorded for the same component pair
+	void AddContact(AActor* Actor, UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector Normal);
+
+	FORCEINLINE int32 GetRawContacts() const { return LastRawContacts; }
+	FORCEINLINE int32 GetUniqueContacts() const { return LastUniqueContacts; }
+
+protected:
+	// Contacts waiting to be resolved
+	TArray<FContactRecord> Contacts;
+	// Maps each component pair to its entry in Contacts
+	TMap<TPair<const UPrimitiveComponent*, const UPrimitiveComponent*>, int32> ContactIndex;
+
+	// The number of hit events reported since the last resolve
+	int32 RawContacts;
+	// Counts from the last resolved frame
+	int32 LastRawContacts;
+	int32 LastUniqueContacts;
+};
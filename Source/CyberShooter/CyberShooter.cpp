@@ -6,4 +6,6 @@
 IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, CyberShooter, "CyberShooter" );
 
 DEFINE_LOG_CATEGORY(LogCyberShooter)
+
+DEFINE_STAT(STAT_BlinkVisibilityChanges);
  
\ No newline at end of file
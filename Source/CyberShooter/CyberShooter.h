@@ -5,3 +5,8 @@
 #include "CoreMinimal.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(LogCyberShooter, Log, All);
+
+DECLARE_STATS_GROUP(TEXT("CyberShooter"), STATGROUP_CyberShooter, STATCAT_Advanced);
+
+// Counts actors changing visibility for damage and respawn blinking, each change marks the actor's render state dirty
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Blink Visibility Changes"), STAT_BlinkVisibilityChanges, STATGROUP_CyberShooter, CYBERSHOOTER_API);
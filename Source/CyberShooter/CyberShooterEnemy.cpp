@@ -9,7 +9,10 @@
 #include "CyberShooterGameInstance.h"
 #include "Spawner.h"
 #include "AggroZone.h"
+#include "ActorRegistrySubsystem.h"
 #include "BulletMovementComponent.h"
+#include "ContactSubsystem.h"
+#include "ForceFieldSubsystem.h"
 
 #include "Components/CapsuleComponent.h"
 #include "Components/SplineComponent.h"
@@ -47,8 +50,6 @@ AEnemyBase::AEnemyBase()
 	RespawnDuration = 5.0f;
 	RespawnCooldown = 2.0f;
 
-	RespawnTimer = 0.0f;
-
 	Ephemeral = false;
 }
 
@@ -63,62 +64,38 @@ void AEnemyBase::BeginPlay()
 		controller->SetAimProfile(DefaultAiming);
 		controller->SetMovementProfile(DefaultMovement);
 	}
+
+	// Pick up zones that baked their membership instead of registering at runtime
+	UActorRegistrySubsystem* registry = UActorRegistrySubsystem::Get(this);
+	if (registry != nullptr && !Ephemeral)
+	{
+		TArray<AAggroZone*> zones;
+		registry->FindBakedZones(this, zones);
+		for (int32 i = 0; i < zones.Num(); ++i)
+		{
+			ParentZone.AddUnique(zones[i]);
+		}
+	}
 }
 
 void AEnemyBase::Tick(float DeltaSeconds)
 {
 	Super::Tick(DeltaSeconds);
 
-	DeltaSeconds *= TickSpeed;
-
 	// Fire the pawn's weapon
 	if (FireWeapon)
 	{
 		Fire(AimComponent->GetForwardVector());
 	}
-
-	// Manage the respawn timer
-	if (RespawnTimer > 0.0f)
-	{
-		RespawnTimer -= DeltaSeconds;
-		if (RespawnTimer <= 0.0f)
-		{
-			if (Respawned)
-			{
-				// Check for collisions at the enemy's position and respawn if the location is clear, otherwise restart the spawn cooldown
-				FHitResult hit;
-				if (SafeRespawn && GetWorld()->SweepSingleByChannel(hit, GetActorLocation(), GetActorLocation(), GetActorQuat(), CollisionComponent->GetCollisionObjectType(), CollisionComponent->GetCollisionShape()))
-				{
-					RespawnTimer = RespawnCooldown;
-					DamageCooldown = RespawnTimer;
-				}
-				else
-				{
-					CancelRespawn();
-				}
-			}
-			else
-			{
-				if (OutOfBoundsRespawn)
-				{
-					// Take fall damage then respawn if possible
-					Damage(1, DAMAGETYPE_NONE, nullptr);
-					if (!Disabled)
-					{
-						Respawn();
-					}
-				}
-				else
-				{
-					// Kill the pawn when out of bounds
-					Kill();
-				}
-			}
-		}
-	}
 }
 
 void AEnemyBase::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
+{
+	// Contacts are resolved once per frame by the contact subsystem
+	UContactSubsystem::ReportHit(this, HitComp, OtherActor, OtherComp, Hit);
+}
+
+void AEnemyBase::ResolveContact(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector Normal, FVector Velocity, FVector OtherVelocity)
 {
 	// Apply contact damage and knockback to players
 	ACyberShooterPlayer* player = Cast<ACyberShooterPlayer>(OtherActor);
@@ -136,14 +113,22 @@ void AEnemyBase::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimit
 
 void AEnemyBase::StartRespawn()
 {
-	RespawnTimer = RespawnDuration;
-	DamageCooldown = RespawnTimer;
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers != nullptr)
+	{
+		timers->SetTimer(TimerHandle_RespawnTimer, this, &AEnemyBase::RespawnTimeout, RespawnDuration, false, TickSpeed);
+	}
+	DamageCooldown = RespawnDuration;
 }
 
 void AEnemyBase::CancelRespawn()
 {
 	// Clear the respawn timer and any respawn effects
-	RespawnTimer = 0.0f;
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers != nullptr)
+	{
+		timers->ClearTimer(TimerHandle_RespawnTimer);
+	}
 	DamageCooldown = 0.0f;
 	SetActorHiddenInGame(false);
 	SetActorEnableCollision(true);
@@ -158,8 +143,12 @@ void AEnemyBase::Respawn()
 	// Disable collision and set the respawn timer to prevent the enemy from popping in on top of the player
 	SetActorEnableCollision(false);
 	Respawned = true;
-	RespawnTimer = RespawnCooldown;
-	DamageCooldown = RespawnTimer;
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers != nullptr)
+	{
+		timers->SetTimer(TimerHandle_RespawnTimer, this, &AEnemyBase::RespawnTimeout, RespawnCooldown, false, TickSpeed);
+	}
+	DamageCooldown = RespawnCooldown;
 
 	// Deactivate AI
 	AEnemyAIController* controller = Cast<AEnemyAIController>(GetController());
@@ -209,7 +198,7 @@ void AEnemyBase::Kill()
 	{
 		for (int32 i = 0; i < ParentZone.Num(); ++i)
 		{
-			ParentZone[i]->NotifyDespawn();
+			ParentZone[i]->NotifyDespawn(this);
 		}
 	}
 
@@ -266,13 +255,19 @@ void AEnemyBase::AggroDisable()
 
 void AEnemyBase::RegisterZone(AAggroZone* Zone)
 {
+	// Rooms register their actors each time they are shown, so a zone may register the same actor again
 	if (!Ephemeral)
 	{
-		ParentZone.Add(Zone);
+		ParentZone.AddUnique(Zone);
 		Zone->NotifyRegister();
 	}
 }
 
+bool AEnemyBase::BakeZone(AAggroZone* Zone)
+{
+	return !Ephemeral;
+}
+
 /// Accessors ///
 
 FVector AEnemyBase::GetAimVector() const
@@ -322,6 +317,13 @@ void AEnemyBase::DisablePawn()
 			controller->SetActorTickEnabled(false);
 		}
 
+		// Stop the respawn timer, enabling the pawn will restart it
+		UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+		if (timers != nullptr)
+		{
+			timers->ClearTimer(TimerHandle_RespawnTimer);
+		}
+
 		ACyberShooterPawn::DisablePawn();
 	}
 }
@@ -382,6 +384,48 @@ void AEnemyBase::CheckAIDisable()
 	}
 }
 
+void AEnemyBase::RespawnTimeout()
+{
+	if (Disabled)
+		return;
+
+	if (Respawned)
+	{
+		// Check for collisions at the enemy's position and respawn if the location is clear, otherwise restart the spawn cooldown
+		FHitResult hit;
+		if (SafeRespawn && GetWorld()->SweepSingleByChannel(hit, GetActorLocation(), GetActorLocation(), GetActorQuat(), CollisionComponent->GetCollisionObjectType(), CollisionComponent->GetCollisionShape()))
+		{
+			UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+			if (timers != nullptr)
+			{
+				timers->SetTimer(TimerHandle_RespawnTimer, this, &AEnemyBase::RespawnTimeout, RespawnCooldown, false, TickSpeed);
+			}
+			DamageCooldown = RespawnCooldown;
+		}
+		else
+		{
+			CancelRespawn();
+		}
+	}
+	else
+	{
+		if (OutOfBoundsRespawn)
+		{
+			// Take fall damage then respawn if possible
+			Damage(1, DAMAGETYPE_NONE, nullptr);
+			if (!Disabled)
+			{
+				Respawn();
+			}
+		}
+		else
+		{
+			// Kill the pawn when out of bounds
+			Kill();
+		}
+	}
+}
+
 ///
 /// AEnemyTurret ///
 ///
@@ -476,13 +520,34 @@ void AEnemySeeker::BeginPlay()
 	MovementComponent->Disable();
 
 	// Set world physics
-	ResetGravity();
-	ResetAirFriction();
-	ResetMass();
+	UCyberShooterGameInstance* instance = Cast<UCyberShooterGameInstance>(GetWorld()->GetGameInstance());
+	if (instance != nullptr)
+	{
+		PhysicsModifiers.SetBase(instance->GetGravity(), instance->GetAirFriction());
+	}
+	ApplyPhysicsModifiers();
+
+	// Receive the static forces of force fields
+	UForceFieldSubsystem* fields = GetWorld()->GetSubsystem<UForceFieldSubsystem>();
+	if (fields != nullptr)
+	{
+		fields->RegisterBody(this);
+	}
 
 	RespawnLocation = GetActorLocation();
 }
 
+void AEnemySeeker::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UForceFieldSubsystem* fields = GetWorld()->GetSubsystem<UForceFieldSubsystem>();
+	if (fields != nullptr)
+	{
+		fields->UnregisterBody(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 FVector AEnemySeeker::GetVelocity() const
 {
 	return MovementComponent->GetTotalVelocity();
@@ -501,7 +566,7 @@ void AEnemySeeker::Respawn()
 	MovementComponent->Disable();
 }
 
-void AEnemySeeker::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
+void AEnemySeeker::ResolveContact(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector Normal, FVector Velocity, FVector OtherVelocity)
 {
 	if (OtherActor != nullptr && OtherActor != this)
 	{
@@ -509,7 +574,7 @@ void AEnemySeeker::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrim
 		if (object != nullptr)
 		{
 			// Handle the collision
-			MovementComponent->Impact(object, Hit.Normal);
+			MovementComponent->Impact(object, Normal, Velocity, OtherVelocity);
 		}
 
 		// Apply contact damage and knockback to players
@@ -574,7 +639,7 @@ void AEnemySeeker::AddRelativeImpulse(FVector Force)
 
 void AEnemySeeker::AddStaticForce(FVector Force)
 {
-	MovementComponent->SetStaticForce(Force);
+	MovementComponent->SetStaticForce(PhysicsModifiers.GetForce() + Force);
 }
 
 void AEnemySeeker::RemoveStaticForce(FVector Force)
@@ -584,66 +649,52 @@ void AEnemySeeker::RemoveStaticForce(FVector Force)
 
 void AEnemySeeker::ResetStaticForce()
 {
-	MovementComponent->ResetStaticForce();
-}
-
-void AEnemySeeker::SetGravity(float NewGravity)
-{
-	WorldGravity = NewGravity;
-	MovementComponent->Gravity = GravityMultiplier * WorldGravity;
-}
-
-void AEnemySeeker::ResetGravity()
-{
-	UCyberShooterGameInstance* instance = Cast<UCyberShooterGameInstance>(GetWorld()->GetGameInstance());
-	if (instance != nullptr)
+	// Fall back to the forces applied by zones
+	if (PhysicsModifiers.GetForce().IsZero())
 	{
-		WorldGravity = instance->GetGravity();
-		MovementComponent->Gravity = GravityMultiplier * WorldGravity;
+		MovementComponent->ResetStaticForce();
 	}
-}
-
-void AEnemySeeker::SetAirFriction(float NewFriction)
-{
-	MovementComponent->AirFriction = NewFriction;
-}
-
-void AEnemySeeker::ResetAirFriction()
-{
-	UCyberShooterGameInstance* instance = Cast<UCyberShooterGameInstance>(GetWorld()->GetGameInstance());
-	if (instance != nullptr)
+	else
 	{
-		MovementComponent->AirFriction = instance->GetAirFriction();
+		MovementComponent->SetStaticForce(PhysicsModifiers.GetForce());
 	}
 }
 
-void AEnemySeeker::SetFriction(float NewFriction)
-{
-	MovementComponent->Friction = NewFriction;
-}
-
-void AEnemySeeker::ResetFriction()
+void AEnemySeeker::AddPhysicsModifier(const FPhysicsModifier& Modifier)
 {
-	MovementComponent->Friction = 1.0f;
+	PhysicsModifiers.Add(Modifier);
+	ApplyPhysicsModifiers();
 }
 
-void AEnemySeeker::SetMass(float Multiplier)
+void AEnemySeeker::RemovePhysicsModifier(const UObject* Source)
 {
-	MovementComponent->Mass = Mass * Multiplier;
+	if (PhysicsModifiers.Remove(Source))
+	{
+		ApplyPhysicsModifiers();
+	}
 }
 
-void AEnemySeeker::ResetMass()
+void AEnemySeeker::ApplyPhysicsModifiers()
 {
-	MovementComponent->Mass = Mass;
-}
+	WorldGravity = PhysicsModifiers.GetGravity();
+	MovementComponent->Gravity = GravityMultiplier * WorldGravity;
+	MovementComponent->Friction = PhysicsModifiers.GetFriction();
+	MovementComponent->Mass = Mass * PhysicsModifiers.GetMass();
+	MovementComponent->AirFriction = PhysicsModifiers.GetAirFriction();
 
-void AEnemySeeker::SetTickRate(float NewRate)
-{
-	if (NewRate > 0.0f)
+	if (TickSpeed != PhysicsModifiers.GetTickRate())
 	{
-		TickSpeed = NewRate;
-		MovementComponent->SetTickSpeed(NewRate);
+		TickSpeed = PhysicsModifiers.GetTickRate();
+		MovementComponent->SetTickSpeed(TickSpeed);
+
+		UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+		if (timers != nullptr)
+		{
+			timers->SetTimerScale(TimerHandle_RespawnTimer, TickSpeed);
+		}
 	}
+
+	ResetStaticForce();
 }
 
 float AEnemySeeker::GetMass() const
@@ -695,6 +746,10 @@ AEnemyMinion::AEnemyMinion()
 {
 	// Delete the minion when it is killed
 	Ephemeral = true;
+
+	Parent = nullptr;
+	Pooled = false;
+	PooledDeathSound = nullptr;
 }
 
 void AEnemyMinion::BeginPlay()
@@ -718,12 +773,50 @@ bool AEnemyMinion::IsParent(AActor* Actor)
 	return Parent == Actor;
 }
 
+bool AEnemyMinion::IsInZone(const AAggroZone* Zone) const
+{
+	return Parent != nullptr && Parent->IsInZone(Zone);
+}
+
 void AEnemyMinion::SetAggro(int32 Required, int32 Minimum)
 {
 	RequiredAggro = Required;
 	MinimumAggro = Minimum;
 }
 
+void AEnemyMinion::SetPooled(bool IsPooled)
+{
+	Pooled = IsPooled;
+	PooledDeathSound = DeathSound;
+}
+
+void AEnemyMinion::ActivateMinion(FVector Location, FRotator Rotation)
+{
+	// Move to the spawn point and make it the new respawn location
+	SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+	RespawnLocation = Location;
+
+	// Clear anything left over from the minion's last life
+	DeathSound = PooledDeathSound;
+	ApplyPhysicsModifiers();
+
+	if (Parent != nullptr)
+	{
+		AggroLevel = Parent->GetAggro();
+	}
+
+	// Apply default AI settings
+	AEnemyAIController* controller = Cast<AEnemyAIController>(GetController());
+	if (controller != nullptr)
+	{
+		controller->SetAimProfile(DefaultAiming);
+		controller->SetMovementProfile(DefaultMovement);
+	}
+
+	// Enabling the pawn restores health and starts the same respawn sequence a newly spawned minion uses
+	EnablePawn();
+}
+
 /// ICombatInterface ///
 
 void AEnemyMinion::Kill()
@@ -742,6 +835,19 @@ void AEnemyMinion::QuietKill()
 	Kill();
 }
 
+void AEnemyMinion::Despawn()
+{
+	// Pooled minions stay in the world until their spawner needs them again
+	if (Pooled)
+	{
+		DisablePawn();
+	}
+	else
+	{
+		Super::Despawn();
+	}
+}
+
 ///
 /// AEnemyBouncer ///
 ///
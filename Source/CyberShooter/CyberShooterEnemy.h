@@ -4,7 +4,9 @@
 
 #include "PhysicsInterface.h"
 #include "AggroInterface.h"
+#include "ContactInterface.h"
 #include "EnemyAIController.h"
+#include "TimingWheelSubsystem.h"
 
 #include "CoreMinimal.h"
 #include "CyberShooterPawn.h"
@@ -14,7 +16,7 @@ class ASpawner;
 
 // The base class for enemies
 UCLASS(Abstract, BlueprintType, Blueprintable)
-class CYBERSHOOTER_API AEnemyBase : public ACyberShooterPawn, public IAggroInterface
+class CYBERSHOOTER_API AEnemyBase : public ACyberShooterPawn, public IAggroInterface, public IContactInterface
 {
 	GENERATED_BODY()
 	
@@ -41,6 +43,10 @@ public:
 	// Apply contact damage to a player
 	void ApplyImpact(class ACyberShooterPlayer* Player, UPrimitiveComponent* Comp);
 
+	/// IContactInterface ///
+
+	virtual void ResolveContact(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector Normal, FVector Velocity, FVector OtherVelocity) override;
+
 	/// ICombatInterface ///
 
 	virtual bool Damage(int32 Value, int32 DamageType, UForceFeedbackEffect* RumbleEffect, UPrimitiveComponent* HitComp = nullptr, AActor* Source = nullptr, AActor* Origin = nullptr) override;
@@ -56,6 +62,7 @@ public:
 	virtual void AggroReset() override;
 	virtual void AggroDisable() override;
 	virtual void RegisterZone(class AAggroZone* Zone) override;
+	virtual bool BakeZone(class AAggroZone* Zone) override;
 
 	/// Accessors ///
 	
@@ -91,6 +98,8 @@ protected:
 	void CheckAIEnable();
 	// Check to see if the pawn should disable its AI
 	void CheckAIDisable();
+	// Called when the respawn timer runs out
+	void RespawnTimeout();
 
 	/// Blueprint Events ///
 	
@@ -166,7 +175,7 @@ protected:
 		USceneComponent* AimComponent;
 
 	// The timer for respawns
-	float RespawnTimer;
+	FWheelTimerHandle TimerHandle_RespawnTimer;
 };
 
 // An enemy that can only turn and shoot
@@ -231,13 +240,14 @@ public:
 	AEnemySeeker();
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual FVector GetVelocity() const override;
 
 	virtual void CancelRespawn() override;
 	virtual void Respawn() override;
 
 	// Handle the seeker hitting physics objects
-	virtual void OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
+	virtual void ResolveContact(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector Normal, FVector Velocity, FVector OtherVelocity) override;
 
 	// Order the pawn to move in a direction
 	virtual void AddControlInput(FVector Direction);
@@ -255,15 +265,8 @@ public:
 	void AddStaticForce(FVector Force) override;
 	void RemoveStaticForce(FVector Force) override;
 	void ResetStaticForce() override;
-	void SetGravity(float NewGravity) override;
-	void ResetGravity() override;
-	void SetAirFriction(float NewFriction) override;
-	void ResetAirFriction() override;
-	void SetFriction(float NewFriction) override;
-	void ResetFriction() override;
-	void SetMass(float Multiplier) override;
-	void ResetMass() override;
-	void SetTickRate(float NewRate) override;
+	void AddPhysicsModifier(const FPhysicsModifier& Modifier) override;
+	void RemovePhysicsModifier(const UObject* Source) override;
 	float GetMass() const override;
 	float GetWeight() const override;
 
@@ -285,6 +288,11 @@ public:
 		bool BPIsFalling();
 
 protected:
+	// Copy the effective values of the physics modifier stack to the movement component
+	void ApplyPhysicsModifiers();
+	// The changes applied by the physics zones the seeker is in
+	FPhysicsModifierStack PhysicsModifiers;
+
 	/// Properties ///
 
 	// The gravity modification from abilities
@@ -321,20 +329,39 @@ public:
 	void ClaimPawn(ASpawner* NewParent);
 	// Check to see if an actor is the parent of this minion
 	bool IsParent(AActor* Actor);
+	// Check to see if this minion's parent is controlled by an aggro zone
+	bool IsInZone(const class AAggroZone* Zone) const;
 	// Set the aggro level of the pawn
 	void SetAggro(int32 Required, int32 Minimum);
 
 	// Kill the pawn without making a sound when respawning
 	void QuietKill();
 
+	// Mark the minion as belonging to its spawner's pool so it is disabled instead of destroyed when killed
+	void SetPooled(bool IsPooled);
+	// Bring a pooled minion back into play at a new location
+	void ActivateMinion(FVector Location, FRotator Rotation);
+
 	/// ICombatInterface ///
 
 	virtual void Kill() override;
 
+	/// Accessors ///
+
+	FORCEINLINE bool IsPooled() const { return Pooled; }
+
 protected:
+	virtual void Despawn() override;
+
 	// The spawner that spawned this minion
 	UPROPERTY(VisibleAnywhere)
 		ASpawner* Parent;
+	// If set to true, the minion returns to its spawner's pool when killed
+	UPROPERTY(VisibleAnywhere)
+		bool Pooled;
+	// The death sound to restore when a quietly killed minion is reused
+	UPROPERTY()
+		USoundBase* PooledDeathSound;
 };
 
 // An enemy that bounces off of walls and obstacles
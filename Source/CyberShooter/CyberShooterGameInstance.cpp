@@ -3,25 +3,137 @@
 #include "CyberShooterGameInstance.h"
 #include "CyberShooterSave.h"
 #include "CyberShooterPlayer.h"
+#include "ActorRegistrySubsystem.h"
+#include "GameplayLog.h"
+#include "ProgressJournal.h"
+#include "CyberShooter.h"
 
 #include "Kismet/GameplayStatics.h"
 #include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Async/Async.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/PackageName.h"
+#include "TimerManager.h"
+#include "PlatformFeatures.h"
+#include "SaveGameSystem.h"
+
+static TAutoConsoleVariable<int32> CVarPreloadLevels(
+	TEXT("cs.PreloadLevels"),
+	1,
+	TEXT("Load the level behind a level trigger in the background as the player approaches it.\n")
+	TEXT("0: Load levels when the trigger is touched\n")
+	TEXT("1: Preload levels"),
+	ECVF_Default);
+
+bool UCyberShooterGameInstance::WriteSaveData(const FString& SlotName, int32 UserIndex, const TArray<uint8>& Data)
+{
+#if PLATFORM_DESKTOP
+	// Write next to the slot's file, then replace it so a crash mid-write never leaves a partial save
+	const FString path = GetSaveDataPath(SlotName);
+	const FString temp_path = path + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(Data, *temp_path))
+		return false;
+
+	return IFileManager::Get().Move(*path, *temp_path, true, true);
+#else
+	ISaveGameSystem* save_system = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+	return save_system != nullptr && save_system->SaveGame(false, *SlotName, UserIndex, Data);
+#endif
+}
+
+bool UCyberShooterGameInstance::ReadSaveData(const FString& SlotName, int32 UserIndex, TArray<uint8>& OutData)
+{
+#if PLATFORM_DESKTOP
+	const FString path = GetSaveDataPath(SlotName);
+	if (FFileHelper::LoadFileToArray(OutData, *path, FILEREAD_Silent))
+		return true;
+
+	// Replacing the slot's file deletes it before renaming the finished write, so a crash in between leaves only the temporary file
+	return FFileHelper::LoadFileToArray(OutData, *(path + TEXT(".tmp")), FILEREAD_Silent);
+#else
+	ISaveGameSystem* save_system = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+	return save_system != nullptr && save_system->LoadGame(false, *SlotName, UserIndex, OutData);
+#endif
+}
+
+FString UCyberShooterGameInstance::GetSaveDataPath(const FString& SlotName)
+{
+	return FPaths::ProjectSavedDir() / TEXT("SaveGames") / SlotName + TEXT(".sav");
+}
 
 UCyberShooterGameInstance::UCyberShooterGameInstance()
 {
 	SaveName = "SaveSlot";
 	SaveSlot = 0;
 	SaveGame = nullptr;
+	LevelStateCache = nullptr;
 
 	Gravity = 1000.0f;
 	AirFriction = 0.5f;
+
+	SaveInProgress = false;
+	SavePending = false;
+	WritingGeneration = 0;
+	PendingGeneration = 0;
+
+	PreloadedWorld = nullptr;
+	TravelStartTime = 0.0;
+	TravelPreloaded = false;
+}
+
+void UCyberShooterGameInstance::Init()
+{
+	Super::Init();
+
+	Journal = MakeShared<FProgressJournal, ESPMode::ThreadSafe>();
+	Journal->SetSlot(SaveName);
+
+	FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UCyberShooterGameInstance::LevelLoaded);
+}
+
+void UCyberShooterGameInstance::Shutdown()
+{
+	// Get the last progress records onto the disk
+	if (Journal.IsValid())
+	{
+		Journal->Wait();
+	}
+
+	// Make sure no checkpoint is lost
+	WaitForSave();
+
+	FCoreUObjectDelegates::PostLoadMapWithWorld.RemoveAll(this);
+
+	Super::Shutdown();
 }
 
 void UCyberShooterGameInstance::LoadGame()
 {
+	// A checkpoint being written or queued is newer than the file
+	WaitForSave();
+
 	// Copy save data from the currently selected file
-	SaveGame = Cast<UCyberShooterSave>(UGameplayStatics::LoadGameFromSlot(SaveName, SaveSlot));
-	GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Yellow, "Loading level: " + SaveGame->CurrentLevel);
+	TArray<uint8> data;
+	if (!ReadSaveData(SaveName, SaveSlot, data))
+		return;
+
+	UCyberShooterSave* save = UCyberShooterSave::LoadFromData(MoveTemp(data));
+	if (save == nullptr)
+		return;
+
+	// Apply progress made after the save was written
+	if (Journal.IsValid())
+	{
+		Journal->Replay(save);
+	}
+
+	SaveGame = save;
+	LevelStateCache = nullptr;
+	GAMEPLAY_EVENT(LogCyberShooterLevel, "Loading level", FName(*SaveGame->CurrentLevel), FColor::Yellow);
 
 	LocationID = -1;
 
@@ -29,6 +141,18 @@ void UCyberShooterGameInstance::LoadGame()
 	UGameplayStatics::OpenLevel(GetWorld(), FName(SaveGame->CurrentLevel));
 }
 
+void UCyberShooterGameInstance::NewGame()
+{
+	// Journals left by an earlier game don't apply to the new save, saves created on demand keep them so they can still be replayed
+	if (Journal.IsValid())
+	{
+		Journal->Clear();
+	}
+
+	SaveGame = nullptr;
+	CreateNewSave();
+}
+
 void UCyberShooterGameInstance::SaveCheckpoint(FVector Location)
 {
 	// Make sure a save exists
@@ -42,9 +166,7 @@ void UCyberShooterGameInstance::SaveCheckpoint(FVector Location)
 	SaveGame->Location = Location;
 
 	// Save the game to disk
-	UGameplayStatics::SaveGameToSlot(SaveGame, SaveName, SaveSlot);
-
-	GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Yellow, "Checkpoint saved");
+	WriteSave();
 }
 
 void UCyberShooterGameInstance::SavePlayer()
@@ -53,7 +175,7 @@ void UCyberShooterGameInstance::SavePlayer()
 	CreateNewSave();
 
 	// Save player data
-	ACyberShooterPlayer* player = Cast<ACyberShooterPlayer>(UGameplayStatics::GetPlayerPawn(GetWorld(), 0));
+	ACyberShooterPlayer* player = UActorRegistrySubsystem::FindPlayer(this);
 	if (player != nullptr)
 	{
 		SaveGame->MaxHealth = player->GetMaxHealth();
@@ -66,41 +188,31 @@ void UCyberShooterGameInstance::SavePlayer()
 		SaveGame->PlayerForward = player->GetForwardVector();
 		SaveGame->PlayerUp = player->GetUpVector();
 
-		GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Yellow, "Player data saved");
+		GAMEPLAY_EVENT(LogCyberShooterSave, "Player data saved", player->GetFName(), FColor::Yellow);
 	}
 }
 
-bool UCyberShooterGameInstance::CheckHealthUpgradeCollected(int32 Slot)
+void UCyberShooterGameInstance::JournalPlayer(ACyberShooterPlayer* Player)
 {
-	FLevelState* state = GetLevelState();
-
-	if (state->HealthUpgradeCollected.Num() > Slot)
+	if (Journal.IsValid() && Player != nullptr)
 	{
-		return state->HealthUpgradeCollected[Slot];
+		Journal->RecordPlayer(Player->GetMaxHealth(), Player->GetMaxMomentum(), Player->GetKeys(), Player->GetWeaponSet(), Player->GetAbilitySet());
 	}
-	return false;
 }
 
-bool UCyberShooterGameInstance::CheckMomentumUpgradeCollected(int32 Slot)
+bool UCyberShooterGameInstance::CheckHealthUpgradeCollected(int32 Slot)
 {
-	FLevelState* state = GetLevelState();
+	return FLevelProgress::GetFlag(GetLevelState()->HealthUpgradeCollected, Slot);
+}
 
-	if (state->MomentumUpgradeCollected.Num() > Slot)
-	{
-		return state->MomentumUpgradeCollected[Slot];
-	}
-	return false;
+bool UCyberShooterGameInstance::CheckMomentumUpgradeCollected(int32 Slot)
+{
+	return FLevelProgress::GetFlag(GetLevelState()->MomentumUpgradeCollected, Slot);
 }
 
 bool UCyberShooterGameInstance::CheckKeyCollected(int32 Slot)
 {
-	FLevelState* state = GetLevelState();
-
-	if (state->KeyCollected.Num() > Slot)
-	{
-		return state->KeyCollected[Slot];
-	}
-	return false;
+	return FLevelProgress::GetFlag(GetLevelState()->KeyCollected, Slot);
 }
 
 bool UCyberShooterGameInstance::CheckWeaponCollected(int32 Slot)
@@ -115,91 +227,70 @@ bool UCyberShooterGameInstance::CheckAbilityCollected(int32 Slot)
 
 bool UCyberShooterGameInstance::CheckUnlocked(int32 Slot)
 {
-	FLevelState* state = GetLevelState();
-
-	if (state->LockState.Num() > Slot)
-	{
-		return state->LockState[Slot];
-	}
-	return false;
+	return FLevelProgress::GetFlag(GetLevelState()->LockState, Slot);
 }
 
 void UCyberShooterGameInstance::CollectHealthUpgrade(int32 Slot)
 {
-	FLevelState* state = GetLevelState();
-
-	// Resize the array if needed
-	if (state->HealthUpgradeCollected.Num() <= Slot)
-	{
-		state->HealthUpgradeCollected.SetNum(Slot + 1);
-	}
-	
-	state->HealthUpgradeCollected[Slot] = true;
+	FLevelProgress::SetFlag(GetLevelState()->HealthUpgradeCollected, Slot);
+	RecordProgress(EJournalRecord::HealthUpgrade, Slot);
 }
 
 void UCyberShooterGameInstance::CollectMomentumUpgrade(int32 Slot)
 {
-	FLevelState* state = GetLevelState();
-
-	// Resize the array if needed
-	if (state->MomentumUpgradeCollected.Num() <= Slot)
-	{
-		state->MomentumUpgradeCollected.SetNum(Slot + 1);
-	}
-
-	state->MomentumUpgradeCollected[Slot] = true;
+	FLevelProgress::SetFlag(GetLevelState()->MomentumUpgradeCollected, Slot);
+	RecordProgress(EJournalRecord::MomentumUpgrade, Slot);
 }
 
 void UCyberShooterGameInstance::CollectKey(int32 Slot)
 {
-	FLevelState* state = GetLevelState();
-
-	// Resize the array if needed
-	if (state->KeyCollected.Num() <= Slot)
-	{
-		state->KeyCollected.SetNum(Slot + 1);
-	}
-
-	state->KeyCollected[Slot] = true;
+	FLevelProgress::SetFlag(GetLevelState()->KeyCollected, Slot);
+	RecordProgress(EJournalRecord::Key, Slot);
 }
 
 void UCyberShooterGameInstance::CollectWeapon(int32 Slot)
 {
 	GetLevelState()->WeaponCollected = true;
+	RecordProgress(EJournalRecord::Weapon, Slot);
 }
 
 void UCyberShooterGameInstance::CollectAbility(int32 Slot)
 {
 	GetLevelState()->AbilityCollected = true;
+	RecordProgress(EJournalRecord::Ability, Slot);
 }
 
 void UCyberShooterGameInstance::SaveLock(int32 Slot)
 {
-	FLevelState* state = GetLevelState();
+	FLevelProgress::SetFlag(GetLevelState()->LockState, Slot);
+	RecordProgress(EJournalRecord::Lock, Slot);
+}
+
+UAbilityScript* UCyberShooterGameInstance::GetScript(TSubclassOf<UAbilityScript> ScriptType)
+{
+	if (ScriptType == nullptr)
+		return nullptr;
 
-	// Resize the array if needed
-	if (state->LockState.Num() <= Slot)
+	// Check for an existing script
+	UAbilityScript*& script = Scripts.FindOrAdd(ScriptType);
+	if (script == nullptr)
 	{
-		state->LockState.SetNum(Slot + 1);
+		// Create a new script if one does not exist
+		script = NewObject<UAbilityScript>(this, ScriptType);
 	}
 
-	state->LockState[Slot] = true;
+	return script;
 }
 
-UAbilityScript* UCyberShooterGameInstance::GetScript(TSubclassOf<UAbilityScript> ScriptType)
+void UCyberShooterGameInstance::PreloadScripts(const TArray<UAbility*>& Abilities)
 {
-	// Check for existing scripts
-	for (int32 i = 0; i < Scripts.Num(); ++i)
+	for (int32 i = 0; i < Abilities.Num(); ++i)
 	{
-		if (Scripts[i]->StaticClass() == ScriptType)
+		if (Abilities[i] != nullptr)
 		{
-			return Scripts[i];
+			GetScript(Abilities[i]->Script);
 		}
 	}
-
-	// Create a new script if one does not exist
-	Scripts.Add(NewObject<UAbilityScript>(this, ScriptType));
-	return Scripts.Last();
 }
 
 bool UCyberShooterGameInstance::CreateNewSave()
@@ -208,30 +299,219 @@ bool UCyberShooterGameInstance::CreateNewSave()
 	{
 		// Create the save
 		SaveGame = Cast<UCyberShooterSave>(UGameplayStatics::CreateSaveGameObject(UCyberShooterSave::StaticClass()));
+		LevelStateCache = nullptr;
 
-		GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Yellow, "New save data created");
+		GAMEPLAY_EVENT(LogCyberShooterSave, "New save data created", SaveGame->GetFName(), FColor::Yellow);
 		return true;
 	}
 
 	return false;
 }
 
-FLevelState* UCyberShooterGameInstance::GetLevelState()
+FLevelProgress* UCyberShooterGameInstance::GetLevelState()
 {
 	CreateNewSave();
 
-	// Try to find level data in the current save game
-	FString level = GetWorld()->GetMapName();
-	for (int32 i = 0; i < SaveGame->LevelStatus.Num(); ++i)
+	// Find the level data the first time it is needed in a world, only the current level is ever added so the pointer stays valid
+	UWorld* world = GetWorld();
+	if (LevelStateCache == nullptr || LevelStateWorld.Get() != world)
 	{
-		if (SaveGame->LevelStatus[i].LevelName == level)
+		LevelStateName = FName(*world->GetMapName());
+		LevelStateCache = &SaveGame->GetLevel(LevelStateName);
+		LevelStateWorld = world;
+	}
+
+	return LevelStateCache;
+}
+
+void UCyberShooterGameInstance::RecordProgress(EJournalRecord Type, int32 Slot)
+{
+	if (Journal.IsValid())
+	{
+		Journal->RecordFlag(Type, LevelStateName, Slot);
+	}
+}
+
+void UCyberShooterGameInstance::WriteSave()
+{
+	// Serialize a copy of the save data now so later changes don't affect the write, progress recorded after this goes to a new journal
+	const int32 generation = Journal.IsValid() ? Journal->BeginSnapshot() : 0;
+	SaveGame->JournalGeneration = generation;
+	TArray<uint8> data;
+	SaveGame->WriteArchive(data);
+
+	if (SaveInProgress)
+	{
+		// Replace any snapshot still waiting, it is older than this one
+		PendingSave = MoveTemp(data);
+		PendingGeneration = generation;
+		SavePending = true;
+		return;
+	}
+
+	StartWrite(MoveTemp(data), generation);
+}
+
+void UCyberShooterGameInstance::StartWrite(TArray<uint8>&& Data, int32 JournalGeneration)
+{
+	SaveInProgress = true;
+	WritingGeneration = JournalGeneration;
+
+	TWeakObjectPtr<UCyberShooterGameInstance> instance(this);
+	SaveTask = Async(EAsyncExecution::ThreadPool, [instance, Data = MoveTemp(Data), SlotName = SaveName, UserIndex = SaveSlot]()
+	{
+		const bool success = WriteSaveData(SlotName, UserIndex, Data);
+
+		// Report back on the game thread
+		AsyncTask(ENamedThreads::GameThread, [instance, success]()
 		{
-			return &SaveGame->LevelStatus[i];
+			if (instance.IsValid())
+			{
+				instance->FinishWrite(success);
+			}
+		});
+
+		return success;
+	});
+}
+
+void UCyberShooterGameInstance::FinishWrite(bool Success)
+{
+	SaveInProgress = false;
+	SaveTask = TFuture<bool>();
+
+	if (Success)
+	{
+		// The journal files the save covers are no longer needed
+		if (Journal.IsValid())
+		{
+			Journal->Compact(WritingGeneration);
 		}
+
+		GAMEPLAY_EVENT(LogCyberShooterSave, "Checkpoint saved", FName(*SaveName), FColor::Yellow);
 	}
+	else
+	{
+		UE_LOG(LogCyberShooter, Warning, TEXT("Unable to write save slot %s"), *SaveName);
+	}
+
+	OnSaveComplete.Broadcast(Success);
+
+	// Write the newest snapshot taken while this one was saving
+	if (SavePending)
+	{
+		SavePending = false;
+		StartWrite(MoveTemp(PendingSave), PendingGeneration);
+		PendingSave.Empty();
+	}
+}
+
+void UCyberShooterGameInstance::WaitForSave()
+{
+	// Finish any write that is running, then write the newest snapshot
+	if (SaveTask.IsValid())
+	{
+		SaveTask.Wait();
+	}
+	if (SavePending)
+	{
+		WriteSaveData(SaveName, SaveSlot, PendingSave);
+		SavePending = false;
+		PendingSave.Empty();
+	}
+}
 
-	// Create new level data
-	SaveGame->LevelStatus.Emplace();
-	SaveGame->LevelStatus.Last().LevelName = level;
-	return &SaveGame->LevelStatus.Last();
+/// Level Travel ///
+
+void UCyberShooterGameInstance::PreloadLevel(FName Level)
+{
+	if (Level.IsNone() || Level == PreloadName || CVarPreloadLevels.GetValueOnGameThread() == 0)
+		return;
+
+	// Play in editor duplicates levels as it opens them, so the source package wouldn't be used
+	UWorld* world = GetWorld();
+	if (world == nullptr || world->IsPlayInEditor())
+		return;
+
+	// Triggers name levels by their short name, find the package once and remember it
+	FString* package_name = LevelPackages.Find(Level);
+	if (package_name == nullptr)
+	{
+		FString long_name = Level.ToString();
+		if (FPackageName::IsShortPackageName(long_name) && !FPackageName::SearchForPackageOnDisk(long_name + FPackageName::GetMapPackageExtension(), &long_name))
+		{
+			long_name.Empty();
+		}
+		package_name = &LevelPackages.Add(Level, long_name);
+	}
+	if (package_name->IsEmpty())
+	{
+		UE_LOG(LogCyberShooterLevel, Warning, TEXT("Couldn't find level %s to preload"), *Level.ToString());
+		return;
+	}
+
+	// Only one level is kept preloaded, drop any earlier level so it can be collected
+	PreloadName = Level;
+	PreloadPackageName = FName(**package_name);
+	PreloadedWorld = nullptr;
+
+	GAMEPLAY_EVENT(LogCyberShooterLevel, "Preloading level", Level, FColor::Yellow);
+
+	LoadPackageAsync(*package_name, FLoadPackageAsyncDelegate::CreateUObject(this, &UCyberShooterGameInstance::PreloadComplete));
+}
+
+void UCyberShooterGameInstance::PreloadComplete(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+{
+	// Ignore levels that were replaced by a later preload
+	if (PackageName != PreloadPackageName)
+		return;
+
+	UWorld* world = nullptr;
+	if (Result == EAsyncLoadingResult::Succeeded && LoadedPackage != nullptr)
+	{
+		world = UWorld::FindWorldInPackage(LoadedPackage);
+	}
+
+	if (world != nullptr)
+	{
+		PreloadedWorld = world;
+		GAMEPLAY_EVENT(LogCyberShooterLevel, "Level preloaded", PreloadName, FColor::Yellow);
+	}
+	else
+	{
+		UE_LOG(LogCyberShooterLevel, Warning, TEXT("Failed to preload level %s"), *PreloadName.ToString());
+		PreloadName = NAME_None;
+		PreloadPackageName = NAME_None;
+	}
+}
+
+void UCyberShooterGameInstance::TravelToLevel(FName Level)
+{
+	TravelStartTime = FPlatformTime::Seconds();
+	TravelPreloaded = PreloadedWorld != nullptr && Level == PreloadName;
+
+	GAMEPLAY_EVENT(LogCyberShooterLevel, "Loading level", Level, FColor::Yellow);
+
+	// The engine finds the preloaded package in memory instead of loading it from disk
+	UGameplayStatics::OpenLevel(GetWorld(), Level);
+}
+
+void UCyberShooterGameInstance::LevelLoaded(UWorld* World)
+{
+	// The preloaded world is in use or was passed over, either way it no longer needs to be kept
+	PreloadName = NAME_None;
+	PreloadPackageName = NAME_None;
+	PreloadedWorld = nullptr;
+
+	// Measure up to the first frame of gameplay
+	if (TravelStartTime > 0.0 && World != nullptr)
+	{
+		World->GetTimerManager().SetTimerForNextTick(this, &UCyberShooterGameInstance::ReportTravelTime);
+	}
+}
+
+void UCyberShooterGameInstance::ReportTravelTime()
+{
+	UE_LOG(LogCyberShooterLevel, Log, TEXT("Level travel took %.1f ms (%s)"), (FPlatformTime::Seconds() - TravelStartTime) * 1000.0, TravelPreloaded ? TEXT("preloaded") : TEXT("not preloaded"));
+	TravelStartTime = 0.0;
 }
\ No newline at end of file
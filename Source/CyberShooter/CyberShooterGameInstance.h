@@ -8,6 +8,8 @@
 #include "Engine/GameInstance.h"
 #include "CyberShooterGameInstance.generated.h"
 
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FSaveEvent, bool, Success);
+
 // The game instance
 UCLASS(Blueprintable)
 class CYBERSHOOTER_API UCyberShooterGameInstance : public UGameInstance
@@ -17,6 +19,9 @@ class CYBERSHOOTER_API UCyberShooterGameInstance : public UGameInstance
 public:
 	UCyberShooterGameInstance();
 
+	virtual void Init() override;
+	virtual void Shutdown() override;
+
 	/// Accessors ///
 	
 	FORCEINLINE const class UCyberShooterSave* GetSaveData() const { return SaveGame; };
@@ -25,11 +30,19 @@ public:
 
 	// Load the current save data
 	void LoadGame();
+	// Start a new game in the current save slot, discarding progress journals left by an earlier game
+	UFUNCTION(BlueprintCallable)
+		void NewGame();
 
-	// Save the current checkpoint and then save data to a file
+	// Save the current checkpoint and then save data to a file in the background
 	void SaveCheckpoint(FVector Location);
+	// Returns true while save data is being written to a file
+	UFUNCTION(BlueprintPure)
+		bool IsSaving() const { return SaveInProgress; }
 	// Save the player's status
 	void SavePlayer();
+	// Record the player's upgrades and equipment in the progress journal
+	void JournalPlayer(class ACyberShooterPlayer* Player);
 
 	// Check if a health upgrade has been collected in the current level
 	UFUNCTION(BlueprintPure)
@@ -69,18 +82,54 @@ public:
 	UFUNCTION(BlueprintCallable)
 		void SaveLock(int32 Slot);
 
-	// Retrieve an ability script
+	// Start loading a level and its dependencies in the background so travelling to it doesn't stall
+	void PreloadLevel(FName Level);
+	// Open a level, using the preloaded packages if the level was preloaded
+	void TravelToLevel(FName Level);
+
+	// Retrieve an ability script, creating it the first time a script type is used
 	UAbilityScript* GetScript(TSubclassOf<UAbilityScript> ScriptType);
+	// Create the scripts for a set of abilities ahead of their first use
+	void PreloadScripts(const TArray<UAbility*>& Abilities);
 
 	// The ID of the trigger that sent the player to the current level, set to -1 when the game is loaded from a save
 	UPROPERTY(Category = "Game", VisibleAnywhere)
 		int32 LocationID;
 
+	// Called on the game thread when a save file has finished writing
+	UPROPERTY(BlueprintAssignable)
+		FSaveEvent OnSaveComplete;
+
 protected:
 	// Create new save data to store information
 	bool CreateNewSave();
 	// Get a reference to the current level state, or create a new one if one does not exist
-	struct FLevelState* GetLevelState();
+	struct FLevelProgress* GetLevelState();
+	// Add a change to the current level's state to the progress journal
+	void RecordProgress(enum class EJournalRecord Type, int32 Slot);
+
+	// Snapshot the save data and write it in the background, queueing it if a write is already running
+	void WriteSave();
+	// Start writing a save snapshot on a background thread
+	void StartWrite(TArray<uint8>&& Data, int32 JournalGeneration);
+	// Called on the game thread when a background write finishes
+	void FinishWrite(bool Success);
+	// Block until the running write has finished and write any queued snapshot, so the file holds the latest checkpoint
+	void WaitForSave();
+
+	// Write serialized save data to a slot, called from a background thread
+	static bool WriteSaveData(const FString& SlotName, int32 UserIndex, const TArray<uint8>& Data);
+	// Read a slot's serialized save data, recovering a finished write that wasn't moved into place
+	static bool ReadSaveData(const FString& SlotName, int32 UserIndex, TArray<uint8>& OutData);
+	// Get the file a slot is written to on desktop platforms
+	static FString GetSaveDataPath(const FString& SlotName);
+
+	// Called when a preloaded level package has finished loading
+	void PreloadComplete(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result);
+	// Called after a level has loaded, before its first frame
+	void LevelLoaded(UWorld* World);
+	// Log the time taken to travel to the current level
+	void ReportTravelTime();
 
 	// The save slot name
 	UPROPERTY(Category = "Save Data", EditDefaultsOnly)
@@ -92,6 +141,31 @@ protected:
 	UPROPERTY(Category = "Save Data", EditInstanceOnly)
 		class UCyberShooterSave* SaveGame;
 
+	// The state of the current level, looked up once per world
+	struct FLevelProgress* LevelStateCache;
+	// The world LevelStateCache was found for
+	TWeakObjectPtr<UWorld> LevelStateWorld;
+	// The name of the level LevelStateCache belongs to
+	FName LevelStateName;
+
+	// Records progress between checkpoint saves
+	TSharedPtr<class FProgressJournal, ESPMode::ThreadSafe> Journal;
+
+	// Set to true while a save snapshot is being written
+	bool SaveInProgress;
+	// The newest snapshot taken while another was being written, only the latest one is kept
+	TArray<uint8> PendingSave;
+	// Set to true when PendingSave holds a snapshot that hasn't been written
+	bool SavePending;
+	// The journal generations included in the running and pending snapshots
+	int32 WritingGeneration;
+	int32 PendingGeneration;
+	// The background write, kept so shutdown can wait for it
+	TFuture<bool> SaveTask;
+
+	// The save test drives overlapping writes directly
+	friend class FSaveOverlappingWritesTest;
+
 	// The current world gravity
 	UPROPERTY(Category = "Physics", EditDefaultsOnly)
 		float Gravity;
@@ -99,7 +173,20 @@ protected:
 	UPROPERTY(Category = "Physics", EditDefaultsOnly)
 		float AirFriction;
 
-	// The ability scripts used by the ability system
+	// The level being preloaded and its long package name
+	FName PreloadName;
+	FName PreloadPackageName;
+	// Keeps the preloaded level in memory until it is opened, a referenced package doesn't keep its world from being collected
+	UPROPERTY(Transient)
+		UWorld* PreloadedWorld;
+	// Long package names of levels that have been looked up for preloading
+	TMap<FName, FString> LevelPackages;
+	// The time the last level travel started at, zero once the travel has been reported
+	double TravelStartTime;
+	// Set to true if the last level travel used a preloaded level
+	bool TravelPreloaded;
+
+	// The ability scripts used by the ability system, one instance per script class
 	UPROPERTY(Category = "Scripts", VisibleAnywhere)
-		TArray<UAbilityScript*> Scripts;
+		TMap<UClass*, UAbilityScript*> Scripts;
 };
@@ -0,0 +1,86 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#include "CyberShooterGameInstance.h"
+#include "CyberShooterSave.h"
+#include "CyberShooter.h"
+
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSaveOverlappingWritesTest, "CyberShooter.Save.OverlappingWrites", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSaveOverlappingWritesTest::RunTest(const FString& Parameters)
+{
+	UCyberShooterGameInstance* instance = NewObject<UCyberShooterGameInstance>(GetTransientPackage());
+	instance->SaveName = TEXT("AutomationOverlappingWrites");
+	instance->SaveSlot = 0;
+
+	const FString path = UCyberShooterGameInstance::GetSaveDataPath(instance->SaveName);
+	const FString temp_path = path + TEXT(".tmp");
+	IFileManager::Get().Delete(*path, false, false, true);
+	IFileManager::Get().Delete(*temp_path, false, false, true);
+
+	// Take checkpoints faster than they can be written, only letting some writes finish in between
+	instance->CreateNewSave();
+	const int32 checkpoints = 200;
+	for (int32 i = 0; i < checkpoints; ++i)
+	{
+		instance->SaveGame->TotalKeys = i;
+		instance->WriteSave();
+
+		if (i % 7 == 0)
+		{
+			FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+		}
+	}
+
+	// Loading waits for the running write and writes the queued snapshot, so the file already holds the last checkpoint
+	instance->WaitForSave();
+	TArray<uint8> waited;
+	if (TestTrue(TEXT("Save data can be read after waiting"), UCyberShooterGameInstance::ReadSaveData(instance->SaveName, instance->SaveSlot, waited)))
+	{
+		const UCyberShooterSave* save = UCyberShooterSave::LoadFromData(MoveTemp(waited));
+		if (TestNotNull(TEXT("Waited save data can be parsed"), save))
+		{
+			TestEqual(TEXT("Waiting writes the last checkpoint"), save->TotalKeys, checkpoints - 1);
+		}
+	}
+
+	// Drain the completions of the finished writes
+	for (int32 i = 0; i < checkpoints && instance->SaveInProgress; ++i)
+	{
+		instance->SaveTask.Wait();
+		FTaskGraphInterface::Get().ProcessThreadUntilIdle(ENamedThreads::GameThread);
+	}
+	TestFalse(TEXT("All writes finished"), instance->SaveInProgress || instance->SavePending);
+	TestFalse(TEXT("No temporary file is left behind"), IFileManager::Get().FileExists(*temp_path));
+
+	// The file on disk must hold the last checkpoint
+	TArray<uint8> data;
+	if (TestTrue(TEXT("Save data can be read"), UCyberShooterGameInstance::ReadSaveData(instance->SaveName, instance->SaveSlot, data)))
+	{
+		const UCyberShooterSave* save = UCyberShooterSave::LoadFromData(CopyTemp(data));
+		if (TestNotNull(TEXT("Save data can be parsed"), save))
+		{
+			TestEqual(TEXT("Last checkpoint was written"), save->TotalKeys, checkpoints - 1);
+		}
+	}
+
+	// A crash after the old file was removed leaves only the finished temporary file
+	IFileManager::Get().Move(*temp_path, *path);
+	TArray<uint8> recovered;
+	TestTrue(TEXT("Temporary file is read when the slot file is missing"), UCyberShooterGameInstance::ReadSaveData(instance->SaveName, instance->SaveSlot, recovered));
+	TestTrue(TEXT("Recovered data matches the last write"), recovered == data);
+
+	IFileManager::Get().Delete(*path, false, false, true);
+	IFileManager::Get().Delete(*temp_path, false, false, true);
+	instance->MarkPendingKill();
+
+	return true;
+}
+
+#endif
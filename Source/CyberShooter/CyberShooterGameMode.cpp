@@ -3,6 +3,7 @@
 #include "CyberShooterGameMode.h"
 #include "CyberShooterPlayer.h"
 #include "CyberShooterGameInstance.h"
+#include "ActorRegistrySubsystem.h"
 #include "Kismet/GameplayStatics.h"
 
 ACyberShooterGameMode::ACyberShooterGameMode()
@@ -20,6 +21,15 @@ void ACyberShooterGameMode::LoadGame()
 	}
 }
 
+void ACyberShooterGameMode::NewGame()
+{
+	UCyberShooterGameInstance* instance = Cast<UCyberShooterGameInstance>(GetWorld()->GetGameInstance());
+	if (instance != nullptr)
+	{
+		instance->NewGame();
+	}
+}
+
 void ACyberShooterGameMode::LoadLevel(FString LevelName, int32 LocationID)
 {
 	UCyberShooterGameInstance* instance = Cast<UCyberShooterGameInstance>(GetWorld()->GetGameInstance());
@@ -28,13 +38,13 @@ void ACyberShooterGameMode::LoadLevel(FString LevelName, int32 LocationID)
 		instance->LocationID = LocationID;
 		instance->SavePlayer();
 
-		UGameplayStatics::OpenLevel(GetWorld(), FName(LevelName));
+		instance->TravelToLevel(FName(LevelName));
 	}
 }
 
 void ACyberShooterGameMode::RefillPlayer()
 {
-	ACyberShooterPlayer* player = Cast<ACyberShooterPlayer>(UGameplayStatics::GetPlayerPawn(GetWorld(), 0));
+	ACyberShooterPlayer* player = UActorRegistrySubsystem::FindPlayer(this);
 	if (player != nullptr)
 	{
 		player->Refill();
@@ -17,6 +17,9 @@ public:
 	// Load the current save slot from the game instance
 	UFUNCTION(Exec)
 		void LoadGame();
+	// Start a new game in the current save slot
+	UFUNCTION(Exec)
+		void NewGame();
 	// Move to a level with a specified LocationID
 	UFUNCTION(Exec)
 		void LoadLevel(FString LevelName, int32 LocationID);
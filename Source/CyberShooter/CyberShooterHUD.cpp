@@ -5,6 +5,7 @@
 #include "CyberShooterPlayerController.h"
 #include "UIWidget.h"
 #include "RadialMenuWidget.h"
+#include "ContactSubsystem.h"
 
 #include "Blueprint/UserWidget.h"
 
@@ -59,6 +60,13 @@ void ACyberShooterHUD::DrawHUD()
 			{
 				DrawText("RAD " + FString::SanitizeFloat(controller->GetRadialAngle()), FLinearColor::White, x - 90, 180.0f);
 			}
+
+			// Contacts resolved last frame
+			UContactSubsystem* contacts = GetWorld()->GetSubsystem<UContactSubsystem>();
+			if (contacts != nullptr)
+			{
+				DrawText("HIT " + FString::FromInt(contacts->GetRawContacts()) + " / " + FString::FromInt(contacts->GetUniqueContacts()), FLinearColor::White, x - 90, 220.0f);
+			}
 		}
 	}
 }
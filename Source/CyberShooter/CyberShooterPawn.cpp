@@ -6,6 +6,9 @@
 #include "CyberShooterGameInstance.h"
 #include "Weapon.h"
 #include "Ability.h"
+#include "ActorRegistrySubsystem.h"
+#include "GameplayLog.h"
+#include "CyberShooter.h"
 
 #include "TimerManager.h"
 #include "UObject/ConstructorHelpers.h"
@@ -59,6 +62,7 @@ ACyberShooterPawn::ACyberShooterPawn()
 
 	ShotCooldown = 0.0f;
 	AbilityCooldown = 0.0f;
+	PhysicsInterface = nullptr;
 	DamageCooldown = 0.0f;
 
 	CanUseAbility = true;
@@ -66,6 +70,32 @@ ACyberShooterPawn::ACyberShooterPawn()
 	ShowPawn = true;
 }
 
+void ACyberShooterPawn::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// Look up the physics interface once for weapon recoil
+	PhysicsInterface = Cast<IPhysicsInterface>(this);
+
+	// Add the actor to the world's registry
+	UActorRegistrySubsystem* registry = GetWorld()->GetSubsystem<UActorRegistrySubsystem>();
+	if (registry != nullptr)
+	{
+		registry->RegisterCombatTarget(this);
+	}
+}
+
+void ACyberShooterPawn::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UActorRegistrySubsystem* registry = GetWorld()->GetSubsystem<UActorRegistrySubsystem>();
+	if (registry != nullptr)
+	{
+		registry->UnregisterCombatTarget(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void ACyberShooterPawn::BeginPlay()
 {
 	Super::BeginPlay();
@@ -73,6 +103,9 @@ void ACyberShooterPawn::BeginPlay()
 	Health = MaxHealth;
 	Momentum = MaxMomentum;
 
+	// Seed weapon spread from a checksum of the actor name so shots are repeatable between runs
+	FireStream.Initialize((int32)FCrc::StrCrc32(*GetName()));
+
 	// Call DisablePawn to ensure that the pawn is properly disabled
 	if (Disabled)
 	{
@@ -97,16 +130,20 @@ void ACyberShooterPawn::Tick(float DeltaSeconds)
 	}
 
 	// Blink after taking damage
+	bool hidden = !ShowPawn;
 	if (DamageCooldown > 0.0f)
 	{
 		DamageCooldown -= DeltaSeconds;
 
 		int state = (int)(DamageCooldown * BlinkRate) & 2;
-		SetActorHiddenInGame(!(bool)state);
+		hidden = !(bool)state;
 	}
-	else
+
+	// Only touch the render state when visibility actually changes
+	if (hidden != IsHidden())
 	{
-		SetActorHiddenInGame(!ShowPawn);
+		SetActorHiddenInGame(hidden);
+		INC_DWORD_STAT(STAT_BlinkVisibilityChanges);
 	}
 
 	// Drain momentum when using abilities
@@ -241,16 +278,25 @@ void ACyberShooterPawn::Kill()
 
 	if (Ephemeral)
 	{
-		Destroy();
-		GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Yellow, "Pawn destroyed");
+		Despawn();
+		GAMEPLAY_EVENT(LogCyberShooterCombat, "Pawn destroyed", GetFName(), FColor::Yellow);
 	}
 	else
 	{
 		DisablePawn();
-		GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::Yellow, "Pawn disabled");
+		GAMEPLAY_EVENT(LogCyberShooterCombat, "Pawn disabled", GetFName(), FColor::Yellow);
 	}
 }
 
+float ACyberShooterPawn::GetDamageCooldown() const
+{
+	if (DamageCooldown <= 0.0f)
+		return 0.0f;
+
+	// The cooldown counts down in the pawn's local time
+	return TickSpeed > 0.0f ? DamageCooldown / TickSpeed : DamageCooldown;
+}
+
 /// Accessor Functions ///
 
 void ACyberShooterPawn::StartFiring()
@@ -357,7 +403,7 @@ void ACyberShooterPawn::StopAbility()
 bool ACyberShooterPawn::ActivateAbility()
 {
 	UCyberShooterGameInstance* instance = Cast<UCyberShooterGameInstance>(GetWorld()->GetGameInstance());
-	if (instance != nullptr)
+	if (instance != nullptr && Ability != nullptr)
 	{
 		// Retrieve the ability script then call it
 		UAbilityScript* script = instance->GetScript(Ability->Script);
@@ -372,7 +418,7 @@ bool ACyberShooterPawn::ActivateAbility()
 bool ACyberShooterPawn::DeactivateAbility()
 {
 	UCyberShooterGameInstance* instance = Cast<UCyberShooterGameInstance>(GetWorld()->GetGameInstance());
-	if (instance != nullptr)
+	if (instance != nullptr && Ability != nullptr)
 	{
 		// Retrieve the ability script then call it
 		UAbilityScript* script = instance->GetScript(Ability->Script);
@@ -406,37 +452,38 @@ void ACyberShooterPawn::Fire(FVector FireDirection)
 			UWorld* world = GetWorld();
 			if (world != nullptr)
 			{
-				FVector up = GetUpVector();
-				float angle = -(Weapon->BulletOffset * (Weapon->NumBullets - 1)) / 2.0f;
-				for (int32 i = 0; i < Weapon->NumBullets; ++i)
+				// Move the weapon's baked spread pattern into the space of the shot
+				const FQuat shot = FRotationMatrix::MakeFromXZ(FireDirection, GetUpVector()).ToQuat();
+				const FVector origin = GetActorLocation();
+				const float accuracy = Weapon->FireAccuracy / 2.0f;
+
+				FActorSpawnParameters spawn_params;
+				spawn_params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::DontSpawnIfColliding;
+
+				const TArray<FWeaponSpread>& spread = Weapon->GetSpreadTable();
+				for (int32 i = 0; i < spread.Num(); ++i)
 				{
 					// Add a random variation to the shot angle based on weapon accuracy
-					float random_angle = FMath::RandRange(-Weapon->FireAccuracy / 2.0f, Weapon->FireAccuracy / 2.0f);
-					FRotator rotation = FireDirection.RotateAngleAxis(random_angle + angle, up).Rotation();
-
-					// Spawn a projectile
-					FVector location = GetActorLocation() + rotation.RotateVector(FVector(GunOffset, 0.0f, 0.0f));
-					if (!Weapon->FanBullets)
+					FQuat aim = shot;
+					if (accuracy != 0.0f)
 					{
-						rotation = FireDirection.RotateAngleAxis(random_angle, up).Rotation();
+						aim *= FQuat(FVector::UpVector, FMath::DegreesToRadians(FireStream.FRandRange(-accuracy, accuracy)));
 					}
 
-					FActorSpawnParameters spawn_params;
-					spawn_params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::DontSpawnIfColliding;
-					AActor* projectile = world->SpawnActor(Weapon->Projectile.Get(), &location, &rotation, spawn_params);
+					// Spawn a projectile
+					const FVector location = origin + (aim * spread[i].Muzzle).GetForwardVector() * GunOffset;
+					const FRotator rotation = (aim * spread[i].Direction).Rotator();
+					ACyberShooterProjectile* projectile = Cast<ACyberShooterProjectile>(world->SpawnActor(Weapon->Projectile.Get(), &location, &rotation, spawn_params));
 					if (projectile != nullptr)
 					{
-						Cast<ACyberShooterProjectile>(projectile)->SetSource(this);
+						projectile->SetSource(this);
 
 						// Play the firing sound
 						if (Weapon->Sound != nullptr)
 						{
-							UGameplayStatics::PlaySoundAtLocation(this, Weapon->Sound, GetActorLocation());
+							UGameplayStatics::PlaySoundAtLocation(this, Weapon->Sound, origin);
 						}
 					}
-
-					// Increment angle
-					angle += Weapon->BulletOffset;
 				}
 			}
 
@@ -446,16 +493,20 @@ void ACyberShooterPawn::Fire(FVector FireDirection)
 			// Apply recoil if possible
 			if (Weapon->Recoil != 0.0f)
 			{
-				IPhysicsInterface* physics_object = Cast<IPhysicsInterface>(this);
-				if (physics_object != nullptr)
+				if (PhysicsInterface != nullptr)
 				{
-					physics_object->AddImpulse(-FireDirection * Weapon->Recoil);
+					PhysicsInterface->AddImpulse(-FireDirection * Weapon->Recoil);
 				}
 			}
 		}
 	}
 }
 
+void ACyberShooterPawn::Despawn()
+{
+	Destroy();
+}
+
 FVector ACyberShooterPawn::GetForwardVector() const
 {
 	return RootComponent->GetForwardVector();
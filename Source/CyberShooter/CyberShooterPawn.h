@@ -21,6 +21,8 @@ public:
 	ACyberShooterPawn();
 
 	virtual void BeginPlay() override;
+	virtual void PostInitializeComponents() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaSeconds) override;
 
 	/// ICombatInterface ///
@@ -28,6 +30,7 @@ public:
 	virtual bool Damage(int32 Value, int32 DamageType, UForceFeedbackEffect* RumbleEffect, UPrimitiveComponent* HitComp = nullptr, AActor* Source = nullptr, AActor* Origin = nullptr) override;
 	virtual void Heal(int32 Value) override;
 	virtual void Kill() override;
+	virtual float GetDamageCooldown() const override;
 
 	/// Accessor Functions ///
 
@@ -116,6 +119,9 @@ protected:
 	// Fire the pawn's current weapon
 	void Fire(FVector FireDirection);
 
+	// Remove an ephemeral pawn from play after it has been killed
+	virtual void Despawn();
+
 	/// Properties ///
 
 	// If set to true, this pawn will be ignored by the game until re-enabled
@@ -240,5 +246,10 @@ protected:
 	float AbilityCooldown;
 	float DamageCooldown;
 	bool CanUseAbility;
+
+	// The random stream used for weapon accuracy
+	FRandomStream FireStream;
+	// This pawn as a physics object, or null if it doesn't implement IPhysicsInterface, used for recoil
+	class IPhysicsInterface* PhysicsInterface;
 };
 
@@ -10,6 +10,10 @@
 #include "LevelTrigger.h"
 #include "Weapon.h"
 #include "Ability.h"
+#include "ContactSubsystem.h"
+#include "ActorRegistrySubsystem.h"
+#include "ForceFieldSubsystem.h"
+#include "GameplayLog.h"
 
 #include "Camera/CameraComponent.h"
 #include "GameFramework/SpringArmComponent.h"
@@ -17,12 +21,18 @@
 #include "Kismet/KismetMathLibrary.h"
 #include "Kismet/GameplayStatics.h"
 #include "Materials/MaterialParameterCollectionInstance.h"
-#include "EngineUtils.h"
+#include "WorldCollision.h"
 
 #include "Engine/Engine.h"
 
 const FName ACyberShooterPlayer::MoveForwardBinding("MoveForward");
 const FName ACyberShooterPlayer::MoveRightBinding("MoveRight");
+const FName ACyberShooterPlayer::OcclusionRadiusParameter("OcclusionRadius");
+const FName ACyberShooterPlayer::LookLocationParameter("LookLocation");
+const FName ACyberShooterPlayer::CameraLocationParameter("CameraLocation");
+
+// The smallest change in a camera parameter that is written to the parameter collection
+static const float CameraParameterTolerance = 0.01f;
 
 ACyberShooterPlayer::ACyberShooterPlayer()
 {
@@ -88,6 +98,11 @@ ACyberShooterPlayer::ACyberShooterPlayer()
 	OcclusionRadius = 100.0f;
 	OcclusionTime = 0.5f;
 	OcclusionSize = 0.0f;
+	Occluded = false;
+	CameraOcclusionSize = 0.0f;
+	CameraLookLocation = FVector::ZeroVector;
+	CameraLocation = FVector::ZeroVector;
+	CameraParametersDirty = true;
 
 	Ephemeral = false;
 	Moved = false;
@@ -108,15 +123,13 @@ void ACyberShooterPlayer::BeginPlay()
 		// Move the player to a level that matches the exit from the previous level
 		if (instance->LocationID >= 0)
 		{
-			for (TActorIterator<ALevelTrigger> itr(GetWorld()); itr; ++itr)
+			UActorRegistrySubsystem* registry = GetWorld()->GetSubsystem<UActorRegistrySubsystem>();
+			ALevelTrigger* trigger = registry != nullptr ? registry->FindLevelTrigger(instance->LocationID) : nullptr;
+			if (trigger != nullptr)
 			{
-				// If the exit matches our current locationID, move there
-				if (itr->GetID() == instance->LocationID)
-				{
-					SetActorLocation(itr->GetActorLocation());
-					ApplyOrientation(itr->GetActorForwardVector(), itr->GetActorUpVector(), true);
-					break;
-				}
+				// Move to the exit matching our current locationID
+				SetActorLocation(trigger->GetActorLocation());
+				ApplyOrientation(trigger->GetActorForwardVector(), trigger->GetActorUpVector(), true);
 			}
 		}
 
@@ -132,6 +145,9 @@ void ACyberShooterPlayer::BeginPlay()
 				SetActorLocation(save->Location);
 			}
 		}
+
+		// Create ability scripts now so activating an ability doesn't allocate
+		instance->PreloadScripts(AbilitySet);
 	}
 
 	// Set up the movement component
@@ -139,9 +155,19 @@ void ACyberShooterPlayer::BeginPlay()
 	ApplyOrientation(GetForwardVector(), GetUpVector(), true);
 
 	// Set world physics
-	ResetGravity();
-	ResetAirFriction();
-	ResetMass();
+	UCyberShooterGameInstance* instance = Cast<UCyberShooterGameInstance>(GetWorld()->GetGameInstance());
+	if (instance != nullptr)
+	{
+		PhysicsModifiers.SetBase(instance->GetGravity(), instance->GetAirFriction());
+	}
+	ApplyPhysicsModifiers();
+
+	// Receive the static forces of force fields
+	UForceFieldSubsystem* fields = GetWorld()->GetSubsystem<UForceFieldSubsystem>();
+	if (fields != nullptr)
+	{
+		fields->RegisterBody(this);
+	}
 
 	// Set respawn points
 	for (int32 i = 0; i < RespawnPoints.Num(); ++i)
@@ -167,7 +193,37 @@ void ACyberShooterPlayer::BeginPlay()
 	if (CameraParameterCollection != nullptr)
 	{
 		CameraParameters = GetWorld()->GetParameterCollectionInstance(CameraParameterCollection);
+		CameraParametersDirty = true;
+	}
+}
+
+void ACyberShooterPlayer::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// Add the actor to the world's registry
+	UActorRegistrySubsystem* registry = GetWorld()->GetSubsystem<UActorRegistrySubsystem>();
+	if (registry != nullptr)
+	{
+		registry->Register(this);
+	}
+}
+
+void ACyberShooterPlayer::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UActorRegistrySubsystem* registry = GetWorld()->GetSubsystem<UActorRegistrySubsystem>();
+	if (registry != nullptr)
+	{
+		registry->Unregister(this);
 	}
+
+	UForceFieldSubsystem* fields = GetWorld()->GetSubsystem<UForceFieldSubsystem>();
+	if (fields != nullptr)
+	{
+		fields->UnregisterBody(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void ACyberShooterPlayer::Tick(float DeltaSeconds)
@@ -263,9 +319,18 @@ void ACyberShooterPlayer::Tick(float DeltaSeconds)
 		}
 	}
 
-	// Check to see if the player is occluded from the camera
-	FHitResult trace;
-	if (GetWorld()->LineTraceSingleByChannel(trace, CameraComponent->GetComponentLocation(), GetActorLocation(), ECollisionChannel::ECC_Visibility))
+	// Read the occlusion trace requested last frame, then request the next one
+	UWorld* world = GetWorld();
+	const FVector camera_location = CameraComponent->GetComponentLocation();
+	FTraceDatum occlusion_data;
+	if (world->QueryTraceData(OcclusionTrace, occlusion_data))
+	{
+		Occluded = FHitResult::GetFirstBlockingHit(occlusion_data.OutHits) != nullptr;
+	}
+	OcclusionTrace = world->AsyncLineTraceByChannel(EAsyncTraceType::Single, camera_location, GetActorLocation(), ECollisionChannel::ECC_Visibility);
+
+	// Fade the occlusion mask toward the last known state
+	if (Occluded)
 	{
 		if (OcclusionSize < OcclusionRadius)
 		{
@@ -288,18 +353,34 @@ void ACyberShooterPlayer::Tick(float DeltaSeconds)
 		}
 	}
 
-	// Set the location of the camera mask
+	// Set the location of the camera mask, only writing values that changed so the collection's uniform buffer isn't rebuilt every frame
 	if (CameraParameters != nullptr)
 	{
-		// Set the occlusion radius to our desired size
-		CameraParameters->SetScalarParameterValue("OcclusionRadius", OcclusionSize);
+		// Set the occlusion radius to our desired size, always writing the fully open and closed sizes exactly
+		const bool occlusion_limit = OcclusionSize == 0.0f || OcclusionSize == OcclusionRadius;
+		if (CameraParametersDirty || FMath::Abs(OcclusionSize - CameraOcclusionSize) > CameraParameterTolerance || (occlusion_limit && OcclusionSize != CameraOcclusionSize))
+		{
+			CameraParameters->SetScalarParameterValue(OcclusionRadiusParameter, OcclusionSize);
+			CameraOcclusionSize = OcclusionSize;
+		}
 
 		// Put the farthest edge of the capsule at the player's center
-		FVector offset = GetActorLocation() - CameraComponent->GetComponentLocation();
+		FVector offset = GetActorLocation() - camera_location;
 		offset *= 1.0f - OcclusionRadius / SpringArmComponent->TargetArmLength;
-		CameraParameters->SetVectorParameterValue("LookLocation", CameraComponent->GetComponentLocation() + offset);
+		const FVector look_location = camera_location + offset;
+		if (CameraParametersDirty || !look_location.Equals(CameraLookLocation, CameraParameterTolerance))
+		{
+			CameraParameters->SetVectorParameterValue(LookLocationParameter, look_location);
+			CameraLookLocation = look_location;
+		}
 
-		CameraParameters->SetVectorParameterValue("CameraLocation", CameraComponent->GetComponentLocation());
+		if (CameraParametersDirty || !camera_location.Equals(CameraLocation, CameraParameterTolerance))
+		{
+			CameraParameters->SetVectorParameterValue(CameraLocationParameter, camera_location);
+			CameraLocation = camera_location;
+		}
+
+		CameraParametersDirty = false;
 	}
 }
 
@@ -323,6 +404,14 @@ FVector ACyberShooterPlayer::GetVelocity() const
 }
 
 void ACyberShooterPlayer::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
+{
+	// Contacts are resolved once per frame by the contact subsystem
+	UContactSubsystem::ReportHit(this, HitComp, OtherActor, OtherComp, Hit);
+}
+
+/// IContactInterface ///
+
+void ACyberShooterPlayer::ResolveContact(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector Normal, FVector Velocity, FVector OtherVelocity)
 {
 	if (OtherActor != nullptr && OtherActor != this)
 	{
@@ -332,7 +421,7 @@ void ACyberShooterPlayer::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor
 			if (object->CanMove())
 			{
 				// Handle the collision
-				MovementComponent->Impact(object, Hit.Normal);
+				MovementComponent->Impact(object, Normal, Velocity, OtherVelocity);
 
 				// Add controller rumble
 				if (ImpactRumble != nullptr)
@@ -391,7 +480,7 @@ bool ACyberShooterPlayer::Damage(int32 Value, int32 DamageType, UForceFeedbackEf
 
 void ACyberShooterPlayer::Kill()
 {
-	GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Red, "Player has been killed");
+	GAMEPLAY_EVENT(LogCyberShooterCombat, "Player has been killed", GetFName(), FColor::Red);
 }
 
 /// IPhysicsInterface ///
@@ -423,7 +512,7 @@ void ACyberShooterPlayer::AddRelativeImpulse(FVector Force)
 
 void ACyberShooterPlayer::AddStaticForce(FVector Force)
 {
-	MovementComponent->SetStaticForce(Force);
+	MovementComponent->SetStaticForce(PhysicsModifiers.GetForce() + Force);
 }
 
 void ACyberShooterPlayer::RemoveStaticForce(FVector Force)
@@ -433,70 +522,45 @@ void ACyberShooterPlayer::RemoveStaticForce(FVector Force)
 
 void ACyberShooterPlayer::ResetStaticForce()
 {
-	MovementComponent->ResetStaticForce();
-}
-
-void ACyberShooterPlayer::SetGravity(float NewGravity)
-{
-	WorldGravity = NewGravity;
-	MovementComponent->Gravity = GravityMultiplier * WorldGravity;
-}
-
-void ACyberShooterPlayer::ResetGravity()
-{
-	UCyberShooterGameInstance* instance = Cast<UCyberShooterGameInstance>(GetWorld()->GetGameInstance());
-	if (instance != nullptr)
+	// Fall back to the forces applied by zones
+	if (PhysicsModifiers.GetForce().IsZero())
 	{
-		WorldGravity = instance->GetGravity();
-		MovementComponent->Gravity = GravityMultiplier * WorldGravity;
+		MovementComponent->ResetStaticForce();
+	}
+	else
+	{
+		MovementComponent->SetStaticForce(PhysicsModifiers.GetForce());
 	}
 }
 
-void ACyberShooterPlayer::SetAirFriction(float NewFriction)
+void ACyberShooterPlayer::AddPhysicsModifier(const FPhysicsModifier& Modifier)
 {
-	MovementComponent->AirFriction = NewFriction;
+	PhysicsModifiers.Add(Modifier);
+	ApplyPhysicsModifiers();
 }
 
-void ACyberShooterPlayer::ResetAirFriction()
+void ACyberShooterPlayer::RemovePhysicsModifier(const UObject* Source)
 {
-	UCyberShooterGameInstance* instance = Cast<UCyberShooterGameInstance>(GetWorld()->GetGameInstance());
-	if (instance != nullptr)
+	if (PhysicsModifiers.Remove(Source))
 	{
-		MovementComponent->AirFriction = instance->GetAirFriction();
+		ApplyPhysicsModifiers();
 	}
 }
 
-void ACyberShooterPlayer::SetFriction(float NewFriction)
-{
-	Friction = NewFriction;
-	MovementComponent->Friction = Friction * FrictionMultiplier;
-}
-
-void ACyberShooterPlayer::ResetFriction()
+void ACyberShooterPlayer::ApplyPhysicsModifiers()
 {
-	Friction = 1.0f;
+	WorldGravity = PhysicsModifiers.GetGravity();
+	Friction = PhysicsModifiers.GetFriction();
+	Mass = PhysicsModifiers.GetMass();
+	MovementComponent->Gravity = GravityMultiplier * WorldGravity;
 	MovementComponent->Friction = Friction * FrictionMultiplier;
-}
-
-void ACyberShooterPlayer::SetMass(float NewMass)
-{
-	Mass = NewMass;
 	MovementComponent->Mass = Mass * MassMultiplier;
-}
+	MovementComponent->AirFriction = PhysicsModifiers.GetAirFriction();
 
-void ACyberShooterPlayer::ResetMass()
-{
-	Mass = 1.0f;
-	MovementComponent->Mass = Mass * MassMultiplier;
-}
+	TickSpeed = PhysicsModifiers.GetTickRate();
+	MovementComponent->SetTickSpeed(TickSpeed);
 
-void ACyberShooterPlayer::SetTickRate(float NewRate)
-{
-	if (NewRate > 0.0f)
-	{
-		TickSpeed = NewRate;
-		MovementComponent->SetTickSpeed(NewRate);
-	}
+	ResetStaticForce();
 }
 
 float ACyberShooterPlayer::GetMass() const
@@ -580,6 +644,11 @@ void ACyberShooterPlayer::UpgradeHealth()
 	MaxHealth += 1;
 	Health = MaxHealth;
 
+	if (GameInstanceData != nullptr)
+	{
+		GameInstanceData->JournalPlayer(this);
+	}
+
 	ACyberShooterPlayerController* controller = Cast<ACyberShooterPlayerController>(GetController());
 	if (controller != nullptr)
 	{
@@ -592,6 +661,11 @@ void ACyberShooterPlayer::UpgradeMomentum()
 	MaxMomentum += MomentumBlockSize;
 	Momentum = MaxMomentum * 2;
 
+	if (GameInstanceData != nullptr)
+	{
+		GameInstanceData->JournalPlayer(this);
+	}
+
 	ACyberShooterPlayerController* controller = Cast<ACyberShooterPlayerController>(GetController());
 	if (controller != nullptr)
 	{
@@ -602,6 +676,11 @@ void ACyberShooterPlayer::UpgradeMomentum()
 void ACyberShooterPlayer::AddKey()
 {
 	Keys++;
+
+	if (GameInstanceData != nullptr)
+	{
+		GameInstanceData->JournalPlayer(this);
+	}
 }
 
 void ACyberShooterPlayer::Refill()
@@ -644,6 +723,11 @@ void ACyberShooterPlayer::AddWeapon(UWeapon* NewWeapon)
 	}
 
 	WeaponSet.Add(NewWeapon);
+
+	if (GameInstanceData != nullptr)
+	{
+		GameInstanceData->JournalPlayer(this);
+	}
 }
 
 int32 ACyberShooterPlayer::GetSelectedWeapon()
@@ -678,6 +762,15 @@ void ACyberShooterPlayer::AddAbility(UAbility* NewAbility)
 	}
 
 	AbilitySet.Add(NewAbility);
+
+	if (GameInstanceData != nullptr)
+	{
+		if (NewAbility != nullptr)
+		{
+			GameInstanceData->GetScript(NewAbility->Script);
+		}
+		GameInstanceData->JournalPlayer(this);
+	}
 }
 
 int32 ACyberShooterPlayer::GetSelectedAbility()
@@ -989,7 +1082,7 @@ void ACyberShooterPlayer::Respawn()
 		Damage(1, DAMAGETYPE_ENVIRONMENT, FallRumble);
 		DamageCooldown = RespawnCooldown;
 
-		GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Red, "Player respawned");
+		GAMEPLAY_EVENT(LogCyberShooterCombat, "Player respawned", GetFName(), FColor::Red);
 	}
 	else
 	{
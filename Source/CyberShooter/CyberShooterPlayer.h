@@ -4,6 +4,7 @@
 
 #include "PhysicsInterface.h"
 #include "OrientationInterface.h"
+#include "ContactInterface.h"
 
 #include "CoreMinimal.h"
 #include "CyberShooterPawn.h"
@@ -21,7 +22,7 @@ struct FRespawnPoint
 
 // A player controlled pawn with a camera and input setup
 UCLASS(BlueprintType, Blueprintable)
-class CYBERSHOOTER_API ACyberShooterPlayer : public ACyberShooterPawn, public IPhysicsInterface, public IOrientationInterface
+class CYBERSHOOTER_API ACyberShooterPlayer : public ACyberShooterPawn, public IPhysicsInterface, public IOrientationInterface, public IContactInterface
 {
 	GENERATED_BODY()
 	
@@ -31,6 +32,8 @@ public:
 	/// APawn Functions ///
 
 	virtual void BeginPlay() override;
+	virtual void PostInitializeComponents() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaSeconds) override;
 	virtual void SetupPlayerInputComponent(class UInputComponent* InputComponent) override;
 	virtual FVector GetVelocity() const override;
@@ -39,6 +42,10 @@ public:
 	UFUNCTION()
 		virtual void OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
 
+	/// IContactInterface ///
+
+	virtual void ResolveContact(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector Normal, FVector Velocity, FVector OtherVelocity) override;
+
 	/// ICombatInterface ///
 
 	bool Damage(int32 Value, int32 DamageType, UForceFeedbackEffect* RumbleEffect, UPrimitiveComponent* HitComp = nullptr, AActor* Source = nullptr, AActor* Origin = nullptr) override;
@@ -54,15 +61,8 @@ public:
 	void AddStaticForce(FVector Force) override;
 	void RemoveStaticForce(FVector Force) override;
 	void ResetStaticForce() override;
-	void SetGravity(float NewGravity) override;
-	void ResetGravity() override;
-	void SetAirFriction(float NewFriction) override;
-	void ResetAirFriction() override;
-	void SetFriction(float NewFriction) override;
-	void ResetFriction() override;
-	void SetMass(float NewMass) override;
-	void ResetMass() override;
-	void SetTickRate(float NewRate) override;
+	void AddPhysicsModifier(const FPhysicsModifier& Modifier) override;
+	void RemovePhysicsModifier(const UObject* Source) override;
 	float GetMass() const override;
 	float GetWeight() const override;
 
@@ -192,6 +192,11 @@ public:
 		void ForceRespawn();
 
 protected:
+	// Copy the effective values of the physics modifier stack to the movement component
+	void ApplyPhysicsModifiers();
+	// The changes applied by the physics zones the player is in
+	FPhysicsModifierStack PhysicsModifiers;
+
 	// Apply a specific orientation to the player
 	bool ApplyOrientation(FVector NewForward, FVector NewUp, bool SnapCamera = false);
 	// Transition the camera angle
@@ -208,6 +213,10 @@ protected:
 	// Static names for axis bindings
 	static const FName MoveForwardBinding;
 	static const FName MoveRightBinding;
+	// Static names for camera material parameters
+	static const FName OcclusionRadiusParameter;
+	static const FName LookLocationParameter;
+	static const FName CameraLocationParameter;
 
 	// Save data for debugging
 	UPROPERTY(EditAnywhere)
@@ -349,4 +358,14 @@ protected:
 	bool Moved;
 	// The size of the occlusion mask currently
 	float OcclusionSize;
+	// The async trace checking if the player is hidden from the camera, read on the frame after it is requested
+	FTraceHandle OcclusionTrace;
+	// Set to true when the last finished occlusion trace was blocked
+	bool Occluded;
+	// The camera parameter values last written to the parameter collection
+	float CameraOcclusionSize;
+	FVector CameraLookLocation;
+	FVector CameraLocation;
+	// Set to true when every camera parameter needs to be written on the next tick
+	bool CameraParametersDirty;
 };
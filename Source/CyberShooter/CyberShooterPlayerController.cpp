@@ -5,6 +5,7 @@
 #include "CyberShooterHUD.h"
 #include "Weapon.h"
 #include "Ability.h"
+#include "GameplayLog.h"
 
 #include "Engine/Engine.h"
 
@@ -37,7 +38,7 @@ void ACyberShooterPlayerController::SetupInputComponent()
 
 void ACyberShooterPlayerController::OpenPauseMenu()
 {
-	GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::White, "Main Menu");
+	GAMEPLAY_EVENT(LogCyberShooterMenu, "Main Menu", GetFName(), FColor::White);
 
 	ACyberShooterHUD* hud = Cast<ACyberShooterHUD>(GetHUD());
 	if (hud != nullptr)
@@ -69,7 +70,7 @@ void ACyberShooterPlayerController::OpenPauseMenu()
 
 void ACyberShooterPlayerController::OpenWeaponSelect()
 {
-	GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::White, "Weapon Select Open");
+	GAMEPLAY_EVENT(LogCyberShooterMenu, "Weapon Select Open", GetFName(), FColor::White);
 
 	if (!IsMenuOpen())
 	{
@@ -88,7 +89,7 @@ void ACyberShooterPlayerController::OpenWeaponSelect()
 
 void ACyberShooterPlayerController::CloseWeaponSelect()
 {
-	GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::White, "Weapon Select Closed");
+	GAMEPLAY_EVENT(LogCyberShooterMenu, "Weapon Select Closed", GetFName(), FColor::White);
 
 	if (MenuState == EMenuState::WEAPON_WHEEL)
 	{
@@ -117,7 +118,7 @@ void ACyberShooterPlayerController::CloseWeaponSelect()
 
 void ACyberShooterPlayerController::OpenAbilitySelect()
 {
-	GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::White, "Ability Select Open");
+	GAMEPLAY_EVENT(LogCyberShooterMenu, "Ability Select Open", GetFName(), FColor::White);
 
 	if (!IsMenuOpen())
 	{
@@ -143,7 +144,7 @@ void ACyberShooterPlayerController::OpenAbilitySelect()
 
 void ACyberShooterPlayerController::CloseAbilitySelect()
 {
-	GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::White, "Ability Select Closed");
+	GAMEPLAY_EVENT(LogCyberShooterMenu, "Ability Select Closed", GetFName(), FColor::White);
 
 	if (MenuState == EMenuState::ABILITY_WHEEL)
 	{
@@ -173,7 +174,7 @@ void ACyberShooterPlayerController::CloseAbilitySelect()
 
 void ACyberShooterPlayerController::CloseMenus()
 {
-	GEngine->AddOnScreenDebugMessage(-1, 2.0f, FColor::White, "Close Menus");
+	GAMEPLAY_EVENT(LogCyberShooterMenu, "Close Menus", GetFName(), FColor::White);
 
 	SetPause(false);
 	MenuState = EMenuState::NONE;
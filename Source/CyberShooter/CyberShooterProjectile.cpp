@@ -6,6 +6,7 @@
 #include "BulletMovementComponent.h"
 #include "PhysicsInterface.h"
 #include "CombatInterface.h"
+#include "ForceFieldSubsystem.h"
 
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "UObject/ConstructorHelpers.h"
@@ -42,6 +43,29 @@ ACyberShooterProjectile::ACyberShooterProjectile()
 	Source = nullptr;
 }
 
+void ACyberShooterProjectile::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Receive the static forces of force fields
+	UForceFieldSubsystem* fields = GetWorld()->GetSubsystem<UForceFieldSubsystem>();
+	if (fields != nullptr)
+	{
+		fields->RegisterBody(this);
+	}
+}
+
+void ACyberShooterProjectile::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UForceFieldSubsystem* fields = GetWorld()->GetSubsystem<UForceFieldSubsystem>();
+	if (fields != nullptr)
+	{
+		fields->UnregisterBody(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void ACyberShooterProjectile::SetSource(AActor* ProjectileSource)
 {
 	if (Source == nullptr)
@@ -110,38 +134,45 @@ void ACyberShooterProjectile::OnHit(UPrimitiveComponent* HitComp, AActor* OtherA
 	}
 }
 
-void ACyberShooterProjectile::SetAirFriction(float NewFriction)
-{
-	ProjectileMovement->SetAirFriction(NewFriction);
-}
-
-void ACyberShooterProjectile::ResetAirFriction()
+void ACyberShooterProjectile::AddPhysicsModifier(const FPhysicsModifier& Modifier)
 {
-	UCyberShooterGameInstance* instance = Cast<UCyberShooterGameInstance>(GetWorld()->GetGameInstance());
-	if (instance != nullptr)
+	// Look up the world air friction the first time the projectile enters a zone
+	if (!PhysicsModifiers.HasBase())
 	{
-		ProjectileMovement->SetAirFriction(instance->GetAirFriction());
+		UCyberShooterGameInstance* instance = Cast<UCyberShooterGameInstance>(GetWorld()->GetGameInstance());
+		if (instance != nullptr)
+		{
+			PhysicsModifiers.SetBase(instance->GetGravity(), instance->GetAirFriction());
+		}
 	}
+
+	PhysicsModifiers.Add(Modifier);
+	ApplyPhysicsModifiers();
 }
 
-void ACyberShooterProjectile::SetTickSpeed(float NewSpeed)
+void ACyberShooterProjectile::RemovePhysicsModifier(const UObject* Source)
 {
-	ProjectileMovement->SetTickSpeed(NewSpeed);
+	if (PhysicsModifiers.Remove(Source))
+	{
+		ApplyPhysicsModifiers();
+	}
 }
 
-void ACyberShooterProjectile::ResetTickSpeed()
+void ACyberShooterProjectile::ApplyPhysicsModifiers()
 {
-	ProjectileMovement->SetTickSpeed(1.0f);
+	ProjectileMovement->SetAirFriction(PhysicsModifiers.GetAirFriction());
+	ProjectileMovement->SetTickSpeed(PhysicsModifiers.GetTickRate());
+	ProjectileMovement->SetStaticForce(PhysicsModifiers.GetForce());
 }
 
 void ACyberShooterProjectile::SetStaticForce(FVector NewForce)
 {
-	ProjectileMovement->SetStaticForce(NewForce);
+	ProjectileMovement->SetStaticForce(PhysicsModifiers.GetForce() + NewForce);
 }
 
 void ACyberShooterProjectile::ResetStaticForce()
 {
-	ProjectileMovement->SetStaticForce(FVector(0.0f));
+	ProjectileMovement->SetStaticForce(PhysicsModifiers.GetForce());
 }
 
 void ACyberShooterProjectile::ApplyImpact(AActor* OtherActor, UPrimitiveComponent* OtherComp)
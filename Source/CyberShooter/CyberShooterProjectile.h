@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "PhysicsModifierStack.h"
+
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "CyberShooterProjectile.generated.h"
@@ -20,6 +22,9 @@ class ACyberShooterProjectile : public AActor
 public:
 	ACyberShooterProjectile();
 
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	// Mark what spawned the projectile
 	UFUNCTION()
 		void SetSource(AActor* ProjectileSource);
@@ -27,17 +32,13 @@ public:
 	UFUNCTION()
 		void OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
 
-	// Change the air friction of the projectile
-	void SetAirFriction(float NewFriction);
-	// Reset air friction to the default value in the game instance
-	void ResetAirFriction();
-	// Change the tick speed of the movement component
-	void SetTickSpeed(float NewSpeed);
-	// Reset tick speed to its default value
-	void ResetTickSpeed();
+	// Apply a physics zone's air friction, force and tick rate to the projectile
+	void AddPhysicsModifier(const FPhysicsModifier& Modifier);
+	// Remove the changes applied by a physics zone
+	void RemovePhysicsModifier(const UObject* Source);
 	// Change the static forces applied to the bullet
 	void SetStaticForce(FVector NewForce);
-	// Reset static force to its default value
+	// Reset static force to the forces applied by physics zones
 	void ResetStaticForce();
 
 	FORCEINLINE UBulletMovementComponent* GetProjectileMovement() const { return ProjectileMovement; }
@@ -45,6 +46,11 @@ public:
 protected:
 	// Apply damage and physics effects
 	void ApplyImpact(AActor* OtherActor, UPrimitiveComponent* OtherComp);
+	// Copy the effective values of the physics modifier stack to the movement component
+	void ApplyPhysicsModifiers();
+
+	// The changes applied by the physics zones the projectile is in
+	FPhysicsModifierStack PhysicsModifiers;
 
 	// The projectile's collision
 	UPROPERTY(Category = "Components", VisibleAnywhere)
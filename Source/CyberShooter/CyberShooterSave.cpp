@@ -2,4 +2,549 @@
 
 
 #include "CyberShooterSave.h"
+#include "Weapon.h"
+#include "Ability.h"
+#include "CyberShooter.h"
 
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Kismet/GameplayStatics.h"
+#include "Math/RandomStream.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+// The first four bytes of a compact save archive, "CSSV"
+static const uint32 SaveArchiveMagic = 0x56535343;
+
+// Returns true if file data starts with the compact archive header
+static bool IsSaveArchive(const TArray<uint8>& Data)
+{
+	uint32 magic = 0;
+	if (Data.Num() >= sizeof(magic))
+	{
+		FMemory::Memcpy(&magic, Data.GetData(), sizeof(magic));
+	}
+
+	return magic == SaveArchiveMagic;
+}
+
+// Convert asset references to soft object paths for the archive
+template<class T>
+static TArray<FString> GetAssetPaths(const TArray<T*>& Assets)
+{
+	TArray<FString> paths;
+	paths.Reserve(Assets.Num());
+	for (T* asset : Assets)
+	{
+		if (asset != nullptr)
+		{
+			paths.Add(FSoftObjectPath(asset).ToString());
+		}
+	}
+
+	return paths;
+}
+
+// Load the assets named by soft object paths from the archive, skipping any that no longer exist
+template<class T>
+static void ResolveAssetPaths(const TArray<FString>& Paths, TArray<T*>& Assets)
+{
+	Assets.Reset(Paths.Num());
+	for (const FString& path : Paths)
+	{
+		T* asset = Cast<T>(FSoftObjectPath(path).TryLoad());
+		if (asset != nullptr)
+		{
+			Assets.Add(asset);
+		}
+	}
+}
+
+// Returns true if the string at the reader's position fits in the data that remains, without reading it
+static bool CanReadString(FArchive& Ar)
+{
+	const int64 position = Ar.Tell();
+	int32 length = 0;
+	Ar << length;
+	Ar.Seek(position);
+
+	// Negative lengths mark UTF-16 strings
+	const int64 bytes = length < 0 ? -(int64)length * (int64)sizeof(UTF16CHAR) : (int64)length;
+	return !Ar.IsError() && bytes <= Ar.TotalSize() - position - (int64)sizeof(int32);
+}
+
+// Read a string, failing before allocating if its length runs past the end of the data
+static bool ReadString(FArchive& Ar, FString& OutString)
+{
+	if (!CanReadString(Ar))
+		return false;
+
+	Ar << OutString;
+	return !Ar.IsError();
+}
+
+// Read an array of strings, failing before allocating if the count can't fit in the data that remains
+static bool ReadStringArray(FArchive& Ar, TArray<FString>& OutStrings)
+{
+	int32 num = 0;
+	Ar << num;
+
+	// Every string takes at least its length
+	if (Ar.IsError() || num < 0 || num > (Ar.TotalSize() - Ar.Tell()) / (int64)sizeof(int32))
+		return false;
+
+	OutStrings.Empty(num);
+	for (int32 i = 0; i < num; ++i)
+	{
+		if (!ReadString(Ar, OutStrings.AddDefaulted_GetRef()))
+			return false;
+	}
+
+	return true;
+}
+
+static FAutoConsoleCommand LevelProgressBenchmarkCommand(
+	TEXT("cs.LevelProgressBenchmark"),
+	TEXT("Time collectible lookups at level startup and level progress serialization, comparing the old level state array with the level progress map. Takes an optional collectible count, defaulting to 500."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 num_collectibles = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 500;
+		const int32 num_levels = 50;
+		const int32 passes = 100;
+
+		// Fill every level with the same random progress in both layouts
+		FRandomStream stream(num_collectibles);
+		TArray<FLevelState> states;
+		UCyberShooterSave* save = NewObject<UCyberShooterSave>();
+		for (int32 i = 0; i < num_levels; ++i)
+		{
+			FLevelState& state = states.AddDefaulted_GetRef();
+			state.LevelName = FString::Printf(TEXT("Level%02d"), i);
+			FLevelProgress& progress = save->GetLevel(FName(*state.LevelName));
+
+			for (int32 j = 0; j < num_collectibles; ++j)
+			{
+				const bool collected = stream.FRand() < 0.5f;
+				state.KeyCollected.Add(collected);
+				progress.KeyCollected.Add(collected);
+			}
+		}
+
+		// Start in the last level so the old layout scans every entry
+		const FName level_name(*states.Last().LevelName);
+		int32 found = 0;
+
+		// Every collectible used to build the map name and search the level array in BeginPlay
+		double start = FPlatformTime::Seconds();
+		for (int32 pass = 0; pass < passes; ++pass)
+		{
+			for (int32 j = 0; j < num_collectibles; ++j)
+			{
+				const FString map_name = level_name.ToString();
+				for (const FLevelState& state : states)
+				{
+					if (state.LevelName == map_name)
+					{
+						found += state.KeyCollected.IsValidIndex(j) && state.KeyCollected[j];
+						break;
+					}
+				}
+			}
+		}
+		const double array_lookup_time = (FPlatformTime::Seconds() - start) / passes;
+
+		// The level's progress is found once and each collectible reads a bit
+		start = FPlatformTime::Seconds();
+		for (int32 pass = 0; pass < passes; ++pass)
+		{
+			const FLevelProgress& progress = save->GetLevel(level_name);
+			for (int32 j = 0; j < num_collectibles; ++j)
+			{
+				found += FLevelProgress::GetFlag(progress.KeyCollected, j);
+			}
+		}
+		const double map_lookup_time = (FPlatformTime::Seconds() - start) / passes;
+
+		// Round trip the level through tagged properties as the old saves did
+		TArray<uint8> bytes;
+		int32 array_size = 0;
+		start = FPlatformTime::Seconds();
+		for (int32 pass = 0; pass < passes; ++pass)
+		{
+			bytes.Reset();
+			FMemoryWriter writer(bytes);
+			FLevelState::StaticStruct()->SerializeTaggedProperties(writer, (uint8*)&states.Last(), FLevelState::StaticStruct(), nullptr);
+			array_size = bytes.Num();
+
+			FLevelState copy;
+			FMemoryReader reader(bytes);
+			FLevelState::StaticStruct()->SerializeTaggedProperties(reader, (uint8*)&copy, FLevelState::StaticStruct(), nullptr);
+			found += copy.KeyCollected.Num();
+		}
+		const double array_serialize_time = (FPlatformTime::Seconds() - start) / passes;
+
+		// Round trip the level's bit flags
+		int32 map_size = 0;
+		start = FPlatformTime::Seconds();
+		for (int32 pass = 0; pass < passes; ++pass)
+		{
+			bytes.Reset();
+			FMemoryWriter writer(bytes);
+			save->GetLevel(level_name).Serialize(writer);
+			map_size = bytes.Num();
+
+			FLevelProgress copy;
+			FMemoryReader reader(bytes);
+			copy.Serialize(reader);
+			found += copy.KeyCollected.Num();
+		}
+		const double map_serialize_time = (FPlatformTime::Seconds() - start) / passes;
+
+		save->MarkPendingKill();
+
+		UE_LOG(LogCyberShooter, Log, TEXT("%d collectibles, %d levels (%d)"), num_collectibles, num_levels, found);
+		UE_LOG(LogCyberShooter, Log, TEXT("Startup lookups: level array %.4f ms, level map %.4f ms"), array_lookup_time * 1000.0, map_lookup_time * 1000.0);
+		UE_LOG(LogCyberShooter, Log, TEXT("Level serialization: tagged bools %.4f ms %d bytes, bit flags %.4f ms %d bytes"), array_serialize_time * 1000.0, array_size, map_serialize_time * 1000.0, map_size);
+	}));
+
+static FAutoConsoleCommand SaveArchiveBenchmarkCommand(
+	TEXT("cs.SaveArchiveBenchmark"),
+	TEXT("Time saving and loading a save covering many levels with tagged properties and with the compact archive. Takes an optional level count, defaulting to 50."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 num_levels = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 50;
+		const int32 passes = 20;
+
+		// Give every level a typical spread of locks, keys and upgrades
+		FRandomStream stream(num_levels);
+		UCyberShooterSave* save = NewObject<UCyberShooterSave>();
+		for (int32 i = 0; i < num_levels; ++i)
+		{
+			FLevelProgress& progress = save->GetLevel(FName(*FString::Printf(TEXT("Level%02d"), i)));
+			for (int32 j = 0; j < 32; ++j)
+			{
+				progress.LockState.Add(stream.FRand() < 0.5f);
+				progress.KeyCollected.Add(stream.FRand() < 0.5f);
+			}
+			for (int32 j = 0; j < 4; ++j)
+			{
+				progress.HealthUpgradeCollected.Add(stream.FRand() < 0.5f);
+			}
+			progress.MomentumUpgradeCollected.Add(stream.FRand() < 0.5f);
+			progress.WeaponCollected = stream.FRand() < 0.5f;
+			progress.AbilityCollected = stream.FRand() < 0.5f;
+		}
+		save->CurrentLevel = FString::Printf(TEXT("Level%02d"), num_levels / 2);
+		const FName current_level(*save->CurrentLevel);
+
+		// Tagged properties, the format saves used before the compact archive
+		TArray<uint8> tagged;
+		double start = FPlatformTime::Seconds();
+		for (int32 pass = 0; pass < passes; ++pass)
+		{
+			UGameplayStatics::SaveGameToMemory(save, tagged);
+		}
+		const double tagged_save_time = (FPlatformTime::Seconds() - start) / passes;
+
+		start = FPlatformTime::Seconds();
+		for (int32 pass = 0; pass < passes; ++pass)
+		{
+			UCyberShooterSave* loaded = Cast<UCyberShooterSave>(UGameplayStatics::LoadGameFromMemory(tagged));
+			if (loaded != nullptr)
+			{
+				loaded->GetLevel(current_level);
+				loaded->MarkPendingKill();
+			}
+		}
+		const double tagged_load_time = (FPlatformTime::Seconds() - start) / passes;
+
+		// The compact archive, loading only unpacks the current level
+		TArray<uint8> archive;
+		start = FPlatformTime::Seconds();
+		for (int32 pass = 0; pass < passes; ++pass)
+		{
+			save->WriteArchive(archive);
+		}
+		const double archive_save_time = (FPlatformTime::Seconds() - start) / passes;
+
+		start = FPlatformTime::Seconds();
+		for (int32 pass = 0; pass < passes; ++pass)
+		{
+			UCyberShooterSave* loaded = UCyberShooterSave::LoadFromData(CopyTemp(archive));
+			if (loaded != nullptr)
+			{
+				loaded->GetLevel(current_level);
+				loaded->MarkPendingKill();
+			}
+		}
+		const double archive_load_time = (FPlatformTime::Seconds() - start) / passes;
+
+		save->MarkPendingKill();
+
+		UE_LOG(LogCyberShooter, Log, TEXT("%d levels: tagged save %.3f ms, load %.3f ms, %d bytes"), num_levels, tagged_save_time * 1000.0, tagged_load_time * 1000.0, tagged.Num());
+		UE_LOG(LogCyberShooter, Log, TEXT("%d levels: archive save %.3f ms, load %.3f ms, %d bytes"), num_levels, archive_save_time * 1000.0, archive_load_time * 1000.0, archive.Num());
+	}));
+
+/// FLevelProgress ///
+
+bool FLevelProgress::Serialize(FArchive& Ar)
+{
+	Ar << LockState;
+	Ar << KeyCollected;
+	Ar << HealthUpgradeCollected;
+	Ar << MomentumUpgradeCollected;
+	Ar << WeaponCollected;
+	Ar << AbilityCollected;
+
+	return true;
+}
+
+bool FLevelProgress::GetFlag(const TBitArray<>& Flags, int32 Slot)
+{
+	return Slot >= 0 && Slot < Flags.Num() && Flags[Slot];
+}
+
+void FLevelProgress::SetFlag(TBitArray<>& Flags, int32 Slot)
+{
+	if (Slot < 0)
+		return;
+
+	// Resize the array if needed
+	while (Flags.Num() <= Slot)
+	{
+		Flags.Add(false);
+	}
+
+	Flags[Slot] = true;
+}
+
+/// UCyberShooterSave ///
+
+UCyberShooterSave::UCyberShooterSave()
+{
+	SaveVersion = ESaveVersion::Latest;
+	JournalGeneration = 0;
+}
+
+void UCyberShooterSave::Serialize(FArchive& Ar)
+{
+	// Saves written before the version was stored won't overwrite this
+	if (Ar.IsLoading())
+	{
+		SaveVersion = ESaveVersion::Initial;
+	}
+
+	Super::Serialize(Ar);
+
+	if (Ar.IsLoading())
+	{
+		Upgrade();
+	}
+}
+
+void UCyberShooterSave::Upgrade()
+{
+	if (SaveVersion < ESaveVersion::LevelMap)
+	{
+		// Move level states from the array into the map, converting bool arrays to bit flags
+		for (const FLevelState& state : LevelStatus)
+		{
+			FLevelProgress& progress = Levels.FindOrAdd(FName(*state.LevelName));
+			for (int32 i = 0; i < state.LockState.Num(); ++i)
+			{
+				progress.LockState.Add(state.LockState[i]);
+			}
+			for (int32 i = 0; i < state.KeyCollected.Num(); ++i)
+			{
+				progress.KeyCollected.Add(state.KeyCollected[i]);
+			}
+			for (int32 i = 0; i < state.HealthUpgradeCollected.Num(); ++i)
+			{
+				progress.HealthUpgradeCollected.Add(state.HealthUpgradeCollected[i]);
+			}
+			for (int32 i = 0; i < state.MomentumUpgradeCollected.Num(); ++i)
+			{
+				progress.MomentumUpgradeCollected.Add(state.MomentumUpgradeCollected[i]);
+			}
+			progress.WeaponCollected = state.WeaponCollected;
+			progress.AbilityCollected = state.AbilityCollected;
+		}
+		LevelStatus.Empty();
+	}
+
+	SaveVersion = ESaveVersion::Latest;
+}
+
+/// Save Archive ///
+
+UCyberShooterSave* UCyberShooterSave::LoadFromData(TArray<uint8>&& Data)
+{
+	// Saves written before the compact archive format hold tagged properties
+	if (!IsSaveArchive(Data))
+	{
+		return Cast<UCyberShooterSave>(UGameplayStatics::LoadGameFromMemory(Data));
+	}
+
+	UCyberShooterSave* save = NewObject<UCyberShooterSave>();
+	if (!save->ReadArchive(MoveTemp(Data)))
+	{
+		UE_LOG(LogCyberShooter, Warning, TEXT("Save data is corrupt"));
+		return nullptr;
+	}
+
+	return save;
+}
+
+void UCyberShooterSave::WriteArchive(TArray<uint8>& Data)
+{
+	Data.Reset();
+	FMemoryWriter writer(Data);
+
+	// Write the header, the level table offset is filled in after the sections are written
+	uint32 magic = SaveArchiveMagic;
+	int32 version = ESaveVersion::Latest;
+	int32 table_offset = 0;
+	writer << magic;
+	writer << version;
+	const int64 table_offset_position = writer.Tell();
+	writer << table_offset;
+
+	// Write player data
+	TArray<FString> weapon_paths = GetAssetPaths(Weapons);
+	TArray<FString> ability_paths = GetAssetPaths(Abilities);
+	writer << CurrentLevel;
+	writer << Location;
+	writer << MaxHealth;
+	writer << MaxMomentum;
+	writer << TotalKeys;
+	writer << PlayerUp;
+	writer << PlayerForward;
+	writer << weapon_paths;
+	writer << ability_paths;
+	writer << JournalGeneration;
+
+	// Write a section for each level, levels that were never unpacked are copied without parsing them
+	TArray<TPair<FName, FPackedLevel>> table;
+	table.Reserve(Levels.Num() + PackedLevels.Num());
+	for (TPair<FName, FLevelProgress>& level : Levels)
+	{
+		FPackedLevel section;
+		section.Offset = (int32)writer.Tell();
+		level.Value.Serialize(writer);
+		section.Size = (int32)writer.Tell() - section.Offset;
+		table.Emplace(level.Key, section);
+	}
+	for (const TPair<FName, FPackedLevel>& level : PackedLevels)
+	{
+		FPackedLevel section;
+		section.Offset = (int32)writer.Tell();
+		section.Size = level.Value.Size;
+		writer.Serialize(PackedData.GetData() + level.Value.Offset, level.Value.Size);
+		table.Emplace(level.Key, section);
+	}
+
+	// Write the level table
+	table_offset = (int32)writer.Tell();
+	int32 num_levels = table.Num();
+	writer << num_levels;
+	for (TPair<FName, FPackedLevel>& entry : table)
+	{
+		writer << entry.Key;
+		writer << entry.Value.Offset;
+		writer << entry.Value.Size;
+	}
+
+	writer.Seek(table_offset_position);
+	writer << table_offset;
+}
+
+bool UCyberShooterSave::ReadArchive(TArray<uint8>&& Data)
+{
+	FMemoryReader reader(Data);
+
+	// Read the header
+	uint32 magic = 0;
+	int32 version = 0;
+	int32 table_offset = 0;
+	reader << magic;
+	reader << version;
+	reader << table_offset;
+	if (reader.IsError() || magic != SaveArchiveMagic || version > ESaveVersion::Latest)
+		return false;
+
+	// Read player data
+	TArray<FString> weapon_paths;
+	TArray<FString> ability_paths;
+	if (!ReadString(reader, CurrentLevel))
+		return false;
+	reader << Location;
+	reader << MaxHealth;
+	reader << MaxMomentum;
+	reader << TotalKeys;
+	reader << PlayerUp;
+	reader << PlayerForward;
+	if (!ReadStringArray(reader, weapon_paths) || !ReadStringArray(reader, ability_paths))
+		return false;
+	if (version >= ESaveVersion::ProgressJournal)
+	{
+		reader << JournalGeneration;
+	}
+	if (reader.IsError() || table_offset < reader.Tell() || table_offset > Data.Num())
+		return false;
+
+	ResolveAssetPaths(weapon_paths, Weapons);
+	ResolveAssetPaths(ability_paths, Abilities);
+
+	// Read the level table, the sections are left packed until a level is requested
+	reader.Seek(table_offset);
+	int32 num_levels = 0;
+	reader << num_levels;
+
+	// Each entry holds at least a name length, an offset and a size
+	const int64 min_entry_size = sizeof(int32) * 3;
+	if (reader.IsError() || num_levels < 0 || num_levels > (reader.TotalSize() - reader.Tell()) / min_entry_size)
+		return false;
+
+	Levels.Empty();
+	PackedLevels.Empty(num_levels);
+	for (int32 i = 0; i < num_levels; ++i)
+	{
+		FName name;
+		FPackedLevel section;
+		if (!CanReadString(reader))
+			return false;
+		reader << name;
+		reader << section.Offset;
+		reader << section.Size;
+		if (reader.IsError() || section.Offset < 0 || section.Size < 0 || (int64)section.Offset + section.Size > table_offset)
+			return false;
+
+		PackedLevels.Add(name, section);
+	}
+
+	PackedData = MoveTemp(Data);
+	SaveVersion = ESaveVersion::Latest;
+	return true;
+}
+
+FLevelProgress& UCyberShooterSave::GetLevel(FName Level)
+{
+	FLevelProgress* progress = Levels.Find(Level);
+	if (progress != nullptr)
+	{
+		return *progress;
+	}
+
+	// Unpack the level from the loaded archive if it has a section
+	FLevelProgress& added = Levels.Add(Level);
+	const FPackedLevel* section = PackedLevels.Find(Level);
+	if (section != nullptr)
+	{
+		FMemoryReader reader(PackedData);
+		reader.Seek(section->Offset);
+		added.Serialize(reader);
+		PackedLevels.Remove(Level);
+	}
+
+	return added;
+}
\ No newline at end of file
@@ -6,7 +6,75 @@
 #include "GameFramework/SaveGame.h"
 #include "CyberShooterSave.generated.h"
 
-// The current status of a given level
+// Save file versions, add new versions above VersionPlusOne
+namespace ESaveVersion
+{
+	enum Type
+	{
+		// Level progress stored in an array of FLevelState with bool arrays
+		Initial = 0,
+		// Level progress stored in a map of FLevelProgress keyed by level name with bit flags
+		LevelMap,
+		// Saves written as a compact archive with a level section table instead of tagged properties
+		CompactArchive,
+		// Saves store the last progress journal generation they contain
+		ProgressJournal,
+
+		VersionPlusOne,
+		Latest = VersionPlusOne - 1
+	};
+}
+
+// The progress made in a level
+USTRUCT()
+struct FLevelProgress
+{
+	GENERATED_BODY()
+
+	FLevelProgress() : WeaponCollected(false), AbilityCollected(false) {}
+
+	// Flags for locks that have been unlocked
+	TBitArray<> LockState;
+	// Flags for the number of data keys collected
+	TBitArray<> KeyCollected;
+	// Flags for each health upgrade the player has collected
+	TBitArray<> HealthUpgradeCollected;
+	// A flag for when the player has collected the level's momentum upgrade
+	TBitArray<> MomentumUpgradeCollected;
+
+	// A flag for the level's weapon, if applicable
+	bool WeaponCollected;
+	// A flag for the level's ability, if applicable
+	bool AbilityCollected;
+
+	// Write or read the flags, bit arrays can't be reflected so the struct serializes itself
+	bool Serialize(FArchive& Ar);
+
+	// Returns true if a slot's flag is set, slots past the end of the array are unset
+	static bool GetFlag(const TBitArray<>& Flags, int32 Slot);
+	// Set a slot's flag, growing the array if needed
+	static void SetFlag(TBitArray<>& Flags, int32 Slot);
+};
+
+template<>
+struct TStructOpsTypeTraits<FLevelProgress> : public TStructOpsTypeTraitsBase2<FLevelProgress>
+{
+	enum
+	{
+		WithSerializer = true
+	};
+};
+
+// The location of a level's progress in a loaded save archive
+struct FPackedLevel
+{
+	FPackedLevel() : Offset(0), Size(0) {}
+
+	int32 Offset;
+	int32 Size;
+};
+
+// The status of a given level in saves from before ESaveVersion::LevelMap, only kept to upgrade old saves
 USTRUCT()
 struct FLevelState
 {
@@ -75,7 +143,43 @@ public:
 	UPROPERTY(Category = "Player", EditAnywhere)
 		TArray<class UAbility*> Abilities;
 
-	// The progress made in each individual level
-	UPROPERTY(Category = "Levels", EditAnywhere)
+	// The version the save was written with
+	UPROPERTY()
+		int32 SaveVersion;
+	// The newest progress journal generation included in the save, newer journals are replayed when it is loaded
+	UPROPERTY()
+		int32 JournalGeneration;
+
+	UCyberShooterSave();
+
+	virtual void Serialize(FArchive& Ar) override;
+
+	/// Save Archive ///
+
+	// Create a save from file data in either the compact archive format or the older tagged property format
+	static UCyberShooterSave* LoadFromData(TArray<uint8>&& Data);
+	// Write the save in the compact archive format
+	void WriteArchive(TArray<uint8>& Data);
+
+	// Get the progress for a level, unpacking it from the loaded archive or creating it if needed
+	FLevelProgress& GetLevel(FName Level);
+
+protected:
+	// Convert data loaded from an older save version
+	void Upgrade();
+	// Read the header, player data and level table of a compact archive, level sections stay packed until GetLevel
+	bool ReadArchive(TArray<uint8>&& Data);
+
+	// The progress made in each level that has been unpacked or visited, keyed by map name
+	UPROPERTY(Category = "Levels", VisibleAnywhere)
+		TMap<FName, FLevelProgress> Levels;
+
+	// The archive the save was loaded from
+	TArray<uint8> PackedData;
+	// Sections of PackedData holding levels that haven't been unpacked
+	TMap<FName, FPackedLevel> PackedLevels;
+
+	// The progress made in each individual level in old saves, emptied when the save is upgraded
+	UPROPERTY()
 		TArray<FLevelState> LevelStatus;
 };
@@ -0,0 +1,57 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#include "CyberShooterSave.h"
+#include "CyberShooter.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSaveCorruptArchiveTest, "CyberShooter.Save.CorruptArchive", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSaveCorruptArchiveTest::RunTest(const FString& Parameters)
+{
+	// The header is the magic, the version and the level table offset, followed by the current level
+	const int32 table_offset_position = sizeof(uint32) + sizeof(int32);
+	const int32 current_level_position = table_offset_position + sizeof(int32);
+
+	UCyberShooterSave* save = NewObject<UCyberShooterSave>();
+	save->CurrentLevel = TEXT("Level01");
+	save->GetLevel(TEXT("Level01")).KeyCollected.Add(true);
+	save->GetLevel(TEXT("Level02")).KeyCollected.Add(false);
+
+	TArray<uint8> data;
+	save->WriteArchive(data);
+	TestNotNull(TEXT("Intact archive can be read"), UCyberShooterSave::LoadFromData(CopyTemp(data)));
+
+	int32 table_offset = 0;
+	FMemory::Memcpy(&table_offset, data.GetData() + table_offset_position, sizeof(table_offset));
+
+	// Counts and lengths that don't fit in the file are rejected before anything is allocated for them
+	const int32 huge = MAX_int32;
+	{
+		TArray<uint8> corrupt = data;
+		FMemory::Memcpy(corrupt.GetData() + table_offset, &huge, sizeof(huge));
+		TestNull(TEXT("Level count larger than the file is rejected"), UCyberShooterSave::LoadFromData(MoveTemp(corrupt)));
+	}
+	{
+		TArray<uint8> corrupt = data;
+		FMemory::Memcpy(corrupt.GetData() + current_level_position, &huge, sizeof(huge));
+		TestNull(TEXT("String length larger than the file is rejected"), UCyberShooterSave::LoadFromData(MoveTemp(corrupt)));
+	}
+	{
+		const int32 negative = -huge;
+		TArray<uint8> corrupt = data;
+		FMemory::Memcpy(corrupt.GetData() + current_level_position, &negative, sizeof(negative));
+		TestNull(TEXT("Wide string length larger than the file is rejected"), UCyberShooterSave::LoadFromData(MoveTemp(corrupt)));
+	}
+
+	// A file cut off in the level table is rejected
+	TArray<uint8> truncated = data;
+	truncated.SetNum(table_offset + sizeof(int32) + 2);
+	TestNull(TEXT("Truncated level table is rejected"), UCyberShooterSave::LoadFromData(MoveTemp(truncated)));
+
+	return true;
+}
+
+#endif
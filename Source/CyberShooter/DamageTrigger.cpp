@@ -10,7 +10,8 @@
 
 ADamageTrigger::ADamageTrigger()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	// Cycling and continuous damage run on the timing wheel
+	PrimaryActorTick.bCanEverTick = false;
 
 	OnActorBeginOverlap.AddDynamic(this, &ADamageTrigger::BeginOverlap);
 	OnActorEndOverlap.AddDynamic(this, &ADamageTrigger::EndOverlap);
@@ -44,51 +45,13 @@ ADamageTrigger::ADamageTrigger()
 	TimerOffset = 0.0f;
 }
 
-
-void ADamageTrigger::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-
-	if (Disabled)
-		return;
-
-	if (AutoCycle)
-	{
-		// Increment the activity timer
-		Timer += DeltaTime;
-		if (Active)
-		{
-			if (Timer > ActiveDuration)
-			{
-				// Deactivate the trigger
-				DeactivateTrigger();
-				Timer -= ActiveDuration;
-			}
-		}
-		else
-		{
-			if (Timer > InactiveDuration)
-			{
-				// Activate the trigger
-				ActivateTrigger();
-				Timer -= InactiveDuration;
-			}
-		}
-	}
-
-	// Deal damage to each object inside the trigger
-	if (!InstantDamage && Active)
-	{
-		ApplyDamage();
-	}
-}
-
 void ADamageTrigger::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// Set the default timer
-	Timer = TimerOffset;
+	// Start the cycle from the timer offset
+	SyncCycle();
+	UpdateDamage();
 }
 
 /// Damage Trigger Functions ///
@@ -103,6 +66,12 @@ void ADamageTrigger::BeginOverlap(AActor* OverlappedActor, AActor* OtherActor)
 	if (object != nullptr)
 	{
 		Targets.Add(OtherActor);
+
+		// Damage the new target right away instead of waiting for the other targets' cooldowns
+		if (IsDamaging())
+		{
+			DamageTimeout();
+		}
 	}
 
 	// Apply damage once
@@ -123,6 +92,12 @@ void ADamageTrigger::EndOverlap(AActor* OverlappedActor, AActor* OtherActor)
 	if (object != nullptr)
 	{
 		Targets.Remove(OtherActor);
+
+		// Stop waiting on cooldowns once the trigger is empty
+		if (Targets.Num() == 0)
+		{
+			UpdateDamage();
+		}
 	}
 }
 
@@ -155,10 +130,10 @@ void ADamageTrigger::ActivateTrigger()
 	Active = true;
 	if (InstantDamage)
 	{
-		// Deal damage and cycle the timer
+		// Deal damage once
 		ApplyDamage();
-		Timer += ActiveDuration;
 	}
+	UpdateDamage();
 
 	Activate();
 }
@@ -166,6 +141,7 @@ void ADamageTrigger::ActivateTrigger()
 void ADamageTrigger::DeactivateTrigger()
 {
 	Active = false;
+	UpdateDamage();
 
 	Deactivate();
 }
@@ -174,6 +150,12 @@ void ADamageTrigger::DisableTrigger()
 {
 	Disabled = true;
 
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers != nullptr)
+	{
+		timers->ClearTimer(TimerHandle_CycleTimer);
+	}
+
 	DeactivateTrigger();
 }
 
@@ -181,6 +163,118 @@ void ADamageTrigger::EnableTrigger()
 {
 	Disabled = false;
 
-	Timer = 0.0f;
 	ActivateTrigger();
+	ScheduleCycle(InstantDamage ? 0.0f : ActiveDuration);
+}
+
+/// Timing ///
+
+void ADamageTrigger::CycleTimeout()
+{
+	if (Active)
+	{
+		// Instant damage triggers take their one update of active time out of the inactive phase so the cycle keeps its period
+		DeactivateTrigger();
+		ScheduleCycle(InstantDamage ? InactiveDuration - KINDA_SMALL_NUMBER : InactiveDuration);
+	}
+	else
+	{
+		// Instant damage triggers only stay active until the next update
+		ActivateTrigger();
+		ScheduleCycle(InstantDamage ? 0.0f : ActiveDuration);
+	}
+}
+
+void ADamageTrigger::ScheduleCycle(float Delay)
+{
+	if (!AutoCycle || Disabled)
+		return;
+
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers != nullptr)
+	{
+		// Zero length phases still wait for the next wheel update
+		timers->SetTimer(TimerHandle_CycleTimer, this, &ADamageTrigger::CycleTimeout, FMath::Max(Delay, KINDA_SMALL_NUMBER));
+	}
+}
+
+void ADamageTrigger::SyncCycle()
+{
+	if (!AutoCycle || Disabled)
+		return;
+
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	const float active_duration = InstantDamage ? 0.0f : FMath::Max(ActiveDuration, 0.0f);
+	const float period = FMath::Max(InactiveDuration, 0.0f) + active_duration;
+	if (timers == nullptr || period <= 0.0f)
+		return;
+
+	// Each cycle is the inactive phase followed by the active phase, triggers that start active begin partway through
+	double phase = FMath::Fmod(timers->GetTime() + TimerOffset + (Active ? InactiveDuration : 0.0f), (double)period);
+	if (phase < 0.0)
+	{
+		phase += period;
+	}
+
+	if (phase < InactiveDuration)
+	{
+		if (Active)
+		{
+			DeactivateTrigger();
+		}
+		ScheduleCycle(InactiveDuration - (float)phase);
+	}
+	else
+	{
+		if (!Active)
+		{
+			ActivateTrigger();
+		}
+		ScheduleCycle(period - (float)phase);
+	}
+}
+
+void ADamageTrigger::DamageTimeout()
+{
+	ApplyDamage();
+
+	// Find the first target whose damage cooldown runs out, targets without a cooldown are damaged on the next wheel update
+	float delay = BIG_NUMBER;
+	for (int32 i = 0; i < Targets.Num(); ++i)
+	{
+		ICombatInterface* object = Cast<ICombatInterface>(Targets[i]);
+		if (object != nullptr)
+		{
+			delay = FMath::Min(delay, object->GetDamageCooldown());
+		}
+	}
+
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers != nullptr)
+	{
+		if (IsDamaging() && delay < BIG_NUMBER)
+		{
+			timers->SetTimer(TimerHandle_DamageTimer, this, &ADamageTrigger::DamageTimeout, FMath::Max(delay, KINDA_SMALL_NUMBER));
+		}
+		else
+		{
+			timers->ClearTimer(TimerHandle_DamageTimer);
+		}
+	}
+}
+
+void ADamageTrigger::UpdateDamage()
+{
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers == nullptr)
+		return;
+
+	if (!IsDamaging() || Targets.Num() == 0)
+	{
+		timers->ClearTimer(TimerHandle_DamageTimer);
+	}
+	else if (!timers->IsTimerActive(TimerHandle_DamageTimer))
+	{
+		DamageTimeout();
+	}
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "TimingWheelSubsystem.h"
+
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "DamageTrigger.generated.h"
@@ -18,8 +20,6 @@ class CYBERSHOOTER_API ADamageTrigger : public AActor
 public:	
 	ADamageTrigger();
 
-	virtual void Tick(float DeltaTime) override;
-
 protected:
 	virtual void BeginPlay() override;
 
@@ -60,6 +60,23 @@ public:
 		void Deactivate();
 
 protected:
+	/// Timing ///
+
+	// Switch between the active and inactive state when the cycle timer runs out
+	void CycleTimeout();
+	// Start the cycle timer if the trigger is cycling
+	void ScheduleCycle(float Delay);
+	// Put the trigger at its place in a cycle that starts at wheel time zero, so triggers with matching timings stay in phase
+	void SyncCycle();
+
+	// Damage the targets and wait until the first target can be damaged again
+	void DamageTimeout();
+	// Start or stop continuous damage to match the trigger's state
+	void UpdateDamage();
+
+	// Returns true if the trigger deals damage for as long as it is active
+	FORCEINLINE bool IsDamaging() const { return Active && !InstantDamage && !Disabled; }
+
 	/// Properties ///
 	
 	// The damage that actors will take when inside the trigger
@@ -113,5 +130,7 @@ protected:
 #endif
 
 	// The timer for managing the trigger
-	float Timer;
+	FWheelTimerHandle TimerHandle_CycleTimer;
+	// The timer for dealing continuous damage
+	FWheelTimerHandle TimerHandle_DamageTimer;
 };
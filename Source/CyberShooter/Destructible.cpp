@@ -1,6 +1,8 @@
 // Copyright © 2020 Brian Faubion. All rights reserved.
 
 #include "Destructible.h"
+#include "ActorRegistrySubsystem.h"
+#include "CyberShooter.h"
 
 #include "Kismet/GameplayStatics.h"
 
@@ -23,32 +25,37 @@ ADestructible::ADestructible()
 	Disabled = false;
 	Ephemeral = true;
 
-	PrimaryActorTick.bCanEverTick = true;
-	PrimaryActorTick.bStartWithTickEnabled = false;
+	PrimaryActorTick.bCanEverTick = false;
 }
 
-void ADestructible::BeginPlay()
+void ADestructible::PostInitializeComponents()
 {
-	Super::BeginPlay();
+	Super::PostInitializeComponents();
 
-	Health = MaxHealth;
+	// Add the actor to the world's registry
+	UActorRegistrySubsystem* registry = GetWorld()->GetSubsystem<UActorRegistrySubsystem>();
+	if (registry != nullptr)
+	{
+		registry->RegisterCombatTarget(this);
+	}
 }
 
-void ADestructible::Tick(float DeltaSeconds)
+void ADestructible::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	if (DamageCooldown > 0.0f)
+	UActorRegistrySubsystem* registry = GetWorld()->GetSubsystem<UActorRegistrySubsystem>();
+	if (registry != nullptr)
 	{
-		// Make the actor blink after taking damage
-		DamageCooldown -= DeltaSeconds;
-		int state = (int)(DamageCooldown * BlinkRate) & 2;
-		SetActorHiddenInGame(!(bool)state);
-	}
-	else
-	{
-		// Show the actor if it isn't disabled and stop ticking
-		SetActorHiddenInGame(Disabled);
-		SetActorTickEnabled(false);
+		registry->UnregisterCombatTarget(this);
 	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void ADestructible::BeginPlay()
+{
+	Super::BeginPlay();
+
+	Health = MaxHealth;
 }
 
 void ADestructible::Enable()
@@ -56,14 +63,20 @@ void ADestructible::Enable()
 	Health = MaxHealth;
 
 	// Start the respawn animation
-	DamageCooldown = RespawnCooldown;
-	SetActorTickEnabled(true);
+	StartCooldown(RespawnCooldown);
 	SetActorEnableCollision(true);
 	Disabled = false;
 }
 
 void ADestructible::Disable()
 {
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers != nullptr)
+	{
+		timers->ClearTimer(TimerHandle_DamageCooldown);
+		timers->ClearTimer(TimerHandle_BlinkTimer);
+	}
+
 	SetActorHiddenInGame(true);
 	SetActorEnableCollision(false);
 	Disabled = true;
@@ -71,14 +84,14 @@ void ADestructible::Disable()
 
 bool ADestructible::Damage(int32 Value, int32 DamageType, UForceFeedbackEffect* RumbleEffect, UPrimitiveComponent* HitComp, AActor* Source, AActor* Origin)
 {
-	if (!(DamageImmunity & DamageType) && DamageCooldown <= 0.0f && IsAggro())
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (!(DamageImmunity & DamageType) && (timers == nullptr || !timers->IsTimerActive(TimerHandle_DamageCooldown)) && IsAggro())
 	{
 		Value -= Resistance;
 		if (Value > 0)
 		{
 			Health -= Value;
-			DamageCooldown = DamageCooldownDuration;
-			SetActorTickEnabled(true);
+			StartCooldown(DamageCooldownDuration);
 
 			if (Health <= 0.0f)
 			{
@@ -132,6 +145,41 @@ void ADestructible::Kill()
 	}
 }
 
+void ADestructible::StartCooldown(float Duration)
+{
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers == nullptr || Duration <= 0.0f)
+	{
+		CooldownTimeout();
+	}
+	else
+	{
+		timers->SetTimer(TimerHandle_DamageCooldown, this, &ADestructible::CooldownTimeout, Duration);
+		if (BlinkRate > 0)
+		{
+			// Make the actor blink after taking damage
+			timers->SetTimer(TimerHandle_BlinkTimer, this, &ADestructible::Blink, 2.0f / BlinkRate, true);
+		}
+	}
+}
+
+void ADestructible::CooldownTimeout()
+{
+	// Stop blinking and show the actor if it isn't disabled
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers != nullptr)
+	{
+		timers->ClearTimer(TimerHandle_BlinkTimer);
+	}
+	SetActorHiddenInGame(Disabled);
+}
+
+void ADestructible::Blink()
+{
+	SetActorHiddenInGame(!IsHidden());
+	INC_DWORD_STAT(STAT_BlinkVisibilityChanges);
+}
+
 /// IAggroInterface ///
 
 void ADestructible::Aggro()
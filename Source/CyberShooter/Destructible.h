@@ -4,6 +4,7 @@
 
 #include "CombatInterface.h"
 #include "AggroInterface.h"
+#include "TimingWheelSubsystem.h"
 
 #include "CoreMinimal.h"
 #include "Engine/StaticMeshActor.h"
@@ -18,7 +19,8 @@ public:
 	ADestructible();
 
 	virtual void BeginPlay() override;
-	virtual void Tick(float DeltaSeconds) override;
+	virtual void PostInitializeComponents() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	// Remove the destructible from play
 	void Enable();
@@ -41,6 +43,13 @@ public:
 	virtual void RegisterZone(class AAggroZone* Zone) override {};
 
 protected:
+	// Make the destructible invincible and blink for a duration
+	void StartCooldown(float Duration);
+	// Called when the cooldown runs out
+	void CooldownTimeout();
+	// Toggle visibility during the cooldown
+	void Blink();
+
 	// The aggro counter for the destructible
 	UPROPERTY(Category = "Aggro", EditAnywhere)
 		int32 AggroLevel;
@@ -85,5 +94,7 @@ protected:
 		USoundBase* DeathSound;
 
 	// The timer used to track invincibility after taking damage
-	float DamageCooldown;
+	FWheelTimerHandle TimerHandle_DamageCooldown;
+	// The timer that makes the destructible blink during its cooldown
+	FWheelTimerHandle TimerHandle_BlinkTimer;
 };
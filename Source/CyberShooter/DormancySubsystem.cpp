@@ -0,0 +1,222 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#include "DormancySubsystem.h"
+#include "AggroZone.h"
+#include "TimingWheelSubsystem.h"
+#include "ActorRegistrySubsystem.h"
+#include "CyberShooter.h"
+
+#include "GameFramework/Controller.h"
+#include "GameFramework/MovementComponent.h"
+#include "GameFramework/Pawn.h"
+#include "Components/PrimitiveComponent.h"
+#include "HAL/IConsoleManager.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dormant Actors"), STAT_DormantActors, STATGROUP_CyberShooter);
+
+static FAutoConsoleCommandWithWorld DormancyReportCommand(
+	TEXT("cs.DormancyReport"),
+	TEXT("Log the dormancy state and number of ticking actors for every aggro zone."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		UActorRegistrySubsystem* registry = World->GetSubsystem<UActorRegistrySubsystem>();
+		if (registry != nullptr)
+		{
+			for (AAggroZone* zone : registry->GetAggroZones())
+			{
+				UE_LOG(LogCyberShooter, Log, TEXT("%s: %s, %d / %d actors ticking"), *zone->GetName(), zone->IsDormant() ? TEXT("dormant") : TEXT("awake"), zone->CountTickingActors(), zone->GetNumDormancyActors());
+			}
+		}
+
+		UDormancySubsystem* dormancy = World->GetSubsystem<UDormancySubsystem>();
+		if (dormancy != nullptr)
+		{
+			UE_LOG(LogCyberShooter, Log, TEXT("%d actors dormant"), dormancy->GetNumDormant());
+		}
+	}));
+
+void UDormancySubsystem::Deinitialize()
+{
+	AwakeCounts.Empty();
+	DormantActors.Empty();
+
+	Super::Deinitialize();
+}
+
+void UDormancySubsystem::WakeActor(AActor* Actor)
+{
+	if (Actor == nullptr)
+	{
+		return;
+	}
+
+	int32& count = AwakeCounts.FindOrAdd(Actor);
+	count++;
+
+	if (count == 1 && DormantActors.Contains(Actor))
+	{
+		Resume(Actor);
+	}
+}
+
+void UDormancySubsystem::SleepActor(AActor* Actor)
+{
+	if (Actor == nullptr)
+	{
+		return;
+	}
+
+	int32* count = AwakeCounts.Find(Actor);
+	if (count != nullptr && *count > 0)
+	{
+		(*count)--;
+		if (*count == 0)
+		{
+			Suspend(Actor);
+		}
+	}
+}
+
+bool UDormancySubsystem::IsDormant(AActor* Actor) const
+{
+	return DormantActors.Contains(Actor);
+}
+
+void UDormancySubsystem::ReleaseActor(AActor* Actor)
+{
+	AwakeCounts.Remove(Actor);
+}
+
+void UDormancySubsystem::ForgetUnloadedActors()
+{
+	for (auto it = DormantActors.CreateIterator(); it; ++it)
+	{
+		if (!it.Key().IsValid())
+		{
+			it.RemoveCurrent();
+		}
+	}
+	for (auto it = AwakeCounts.CreateIterator(); it; ++it)
+	{
+		if (!it.Key().IsValid())
+		{
+			it.RemoveCurrent();
+		}
+	}
+
+	SET_DWORD_STAT(STAT_DormantActors, DormantActors.Num());
+}
+
+void UDormancySubsystem::Suspend(AActor* Actor)
+{
+	if (Actor->IsPendingKill() || DormantActors.Contains(Actor))
+	{
+		return;
+	}
+
+	FDormantActorState& state = DormantActors.Add(Actor);
+	state.Hidden = Actor->IsHidden();
+	state.TickEnabled = Actor->IsActorTickEnabled();
+	state.CollisionEnabled = Actor->GetActorEnableCollision();
+
+	// Shut off components
+	TInlineComponentArray<UActorComponent*> components(Actor);
+	for (UActorComponent* component : components)
+	{
+		if (component->IsComponentTickEnabled())
+		{
+			state.TickingComponents.Add(component);
+			component->SetComponentTickEnabled(false);
+		}
+
+		// Movement components may be updated by something other than their own tick
+		if (component->IsA<UMovementComponent>() && component->IsActive())
+		{
+			state.ActiveComponents.Add(component);
+			component->Deactivate();
+		}
+
+		UPrimitiveComponent* primitive = Cast<UPrimitiveComponent>(component);
+		if (primitive != nullptr && primitive->GetGenerateOverlapEvents())
+		{
+			state.OverlapComponents.Add(primitive);
+			primitive->SetGenerateOverlapEvents(false);
+		}
+	}
+
+	// Stop the pawn's controller
+	APawn* pawn = Cast<APawn>(Actor);
+	if (pawn != nullptr && pawn->GetController() != nullptr)
+	{
+		state.Controller = pawn->GetController();
+		state.ControllerTickEnabled = pawn->GetController()->IsActorTickEnabled();
+		pawn->GetController()->SetActorTickEnabled(false);
+	}
+	else
+	{
+		state.ControllerTickEnabled = false;
+	}
+
+	// Hold the actor's gameplay timers
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers != nullptr)
+	{
+		timers->PauseTimersForObject(Actor);
+	}
+
+	// Sleeping actors are invisible, so nothing should be able to hit them
+	Actor->SetActorTickEnabled(false);
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorEnableCollision(false);
+
+	SET_DWORD_STAT(STAT_DormantActors, DormantActors.Num());
+}
+
+void UDormancySubsystem::Resume(AActor* Actor)
+{
+	FDormantActorState state;
+	if (!DormantActors.RemoveAndCopyValue(Actor, state))
+	{
+		return;
+	}
+
+	// Restore everything in one pass
+	Actor->SetActorHiddenInGame(state.Hidden);
+	Actor->SetActorTickEnabled(state.TickEnabled);
+	Actor->SetActorEnableCollision(state.CollisionEnabled);
+
+	for (const TWeakObjectPtr<UActorComponent>& component : state.ActiveComponents)
+	{
+		if (component.IsValid())
+		{
+			component->Activate();
+		}
+	}
+	for (const TWeakObjectPtr<UActorComponent>& component : state.TickingComponents)
+	{
+		if (component.IsValid())
+		{
+			component->SetComponentTickEnabled(true);
+		}
+	}
+	for (const TWeakObjectPtr<UPrimitiveComponent>& primitive : state.OverlapComponents)
+	{
+		if (primitive.IsValid())
+		{
+			primitive->SetGenerateOverlapEvents(true);
+		}
+	}
+
+	if (state.Controller.IsValid())
+	{
+		state.Controller->SetActorTickEnabled(state.ControllerTickEnabled);
+	}
+
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers != nullptr)
+	{
+		timers->UnPauseTimersForObject(Actor);
+	}
+
+	SET_DWORD_STAT(STAT_DormantActors, DormantActors.Num());
+}
@@ -0,0 +1,61 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DormancySubsystem.generated.h"
+
+// The state of an actor before it was made dormant
+struct FDormantActorState
+{
+	bool Hidden;
+	bool TickEnabled;
+	bool CollisionEnabled;
+
+	// Components that were ticking
+	TArray<TWeakObjectPtr<UActorComponent>> TickingComponents;
+	// Movement components that were active
+	TArray<TWeakObjectPtr<UActorComponent>> ActiveComponents;
+	// Primitives that were generating overlap events
+	TArray<TWeakObjectPtr<UPrimitiveComponent>> OverlapComponents;
+
+	// The controller of a dormant pawn
+	TWeakObjectPtr<AController> Controller;
+	bool ControllerTickEnabled;
+};
+
+// Suspends actors that are only referenced by aggro zones the player hasn't visited recently
+UCLASS()
+class CYBERSHOOTER_API UDormancySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Add an awake zone reference to an actor, restoring the actor if it was dormant
+	void WakeActor(AActor* Actor);
+	// Remove an awake zone reference from an actor, suspending it when no awake zones remain
+	void SleepActor(AActor* Actor);
+
+	// Returns true if the actor is currently suspended
+	bool IsDormant(AActor* Actor) const;
+	// Drop an actor's awake zone references, a dormant actor keeps its saved state so it resumes when a zone wakes it again
+	void ReleaseActor(AActor* Actor);
+	// Drop the saved state of dormant actors that have left the world
+	void ForgetUnloadedActors();
+
+	FORCEINLINE int32 GetNumDormant() const { return DormantActors.Num(); }
+
+protected:
+	// Turn off ticking, collision, overlaps and rendering for an actor
+	void Suspend(AActor* Actor);
+	// Restore an actor to the state it was in before it was suspended
+	void Resume(AActor* Actor);
+
+	// The number of awake zones referencing each actor
+	TMap<TWeakObjectPtr<AActor>, int32> AwakeCounts;
+	// Actors that are currently suspended
+	TMap<TWeakObjectPtr<AActor>, FDormantActorState> DormantActors;
+};
@@ -3,6 +3,7 @@
 #include "EnemyAIController.h"
 #include "CyberShooterPlayer.h"
 #include "CyberShooterEnemy.h"
+#include "ActorRegistrySubsystem.h"
 
 #include "Kismet/GameplayStatics.h"
 
@@ -25,7 +26,7 @@ void AEnemyAIController::BeginPlay()
 	Super::BeginPlay();
 
 	// Get a reference to the player and enemy
-	Player = Cast<ACyberShooterPlayer>(UGameplayStatics::GetPlayerPawn(GetWorld(), 0));
+	Player = UActorRegistrySubsystem::FindPlayer(this);
 
 	// Start with AI disabled
 	StopAI();
@@ -0,0 +1,273 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#include "ForceFieldSubsystem.h"
+#include "CyberShooterProjectile.h"
+#include "PhysicsInterface.h"
+#include "CyberShooter.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+DECLARE_CYCLE_STAT(TEXT("Force Fields"), STAT_ForceFields, STATGROUP_CyberShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Force Field Bodies"), STAT_ForceFieldBodies, STATGROUP_CyberShooter);
+
+static FAutoConsoleCommand ForceFieldBenchmarkCommand(
+	TEXT("cs.ForceFieldBenchmark"),
+	TEXT("Time the force field pass against random fields and bodies. Takes an optional field count and body count, defaulting to 20 and 2000."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 num_fields = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 20;
+		const int32 num_bodies = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 2000;
+		const int32 passes = 1000;
+
+		// Scatter an even mix of singularities and directional zones through a space the size of a large room
+		FRandomStream stream(num_fields * 7919 + num_bodies);
+		const FBox bounds(FVector(-5000.0f), FVector(5000.0f));
+
+		TArray<FForceField> fields;
+		for (int32 i = 0; i < num_fields; ++i)
+		{
+			FForceField& field = fields.AddDefaulted_GetRef();
+			field.Type = (i & 1) ? EForceFieldType::Directional : EForceFieldType::Radial;
+			field.Center = stream.RandPointInBox(bounds);
+			field.Radius = stream.FRandRange(500.0f, 2000.0f);
+			field.Rotation = FRotator(0.0f, stream.FRandRange(0.0f, 360.0f), 0.0f).Quaternion();
+			field.Extent = FVector(stream.FRandRange(250.0f, 1500.0f));
+			field.Strength = stream.FRandRange(500.0f, 2000.0f);
+			field.Force = stream.GetUnitVector() * field.Strength;
+		}
+
+		TArray<float> x, y, z, force_x, force_y, force_z;
+		x.SetNumUninitialized(num_bodies);
+		y.SetNumUninitialized(num_bodies);
+		z.SetNumUninitialized(num_bodies);
+		force_x.SetNumZeroed(num_bodies);
+		force_y.SetNumZeroed(num_bodies);
+		force_z.SetNumZeroed(num_bodies);
+		for (int32 i = 0; i < num_bodies; ++i)
+		{
+			const FVector point = stream.RandPointInBox(bounds);
+			x[i] = point.X;
+			y[i] = point.Y;
+			z[i] = point.Z;
+		}
+
+		const double start = FPlatformTime::Seconds();
+		for (int32 pass = 0; pass < passes; ++pass)
+		{
+			UForceFieldSubsystem::EvaluateFields(fields, num_bodies, x.GetData(), y.GetData(), z.GetData(), force_x.GetData(), force_y.GetData(), force_z.GetData());
+		}
+		const double elapsed = FPlatformTime::Seconds() - start;
+
+		UE_LOG(LogCyberShooter, Log, TEXT("%d fields, %d bodies: %.4f ms per pass"), num_fields, num_bodies, elapsed * 1000.0 / passes);
+	}));
+
+UForceFieldSubsystem::UForceFieldSubsystem()
+{
+	ForcesApplied = false;
+}
+
+void UForceFieldSubsystem::Deinitialize()
+{
+	Fields.Empty();
+	Bodies.Empty();
+	BodyIndices.Empty();
+
+	Super::Deinitialize();
+}
+
+/// FTickableGameObject ///
+
+void UForceFieldSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_ForceFields);
+
+	const int32 count = Bodies.Num();
+	SET_DWORD_STAT(STAT_ForceFieldBodies, count);
+
+	// Gather body positions into packed arrays
+	PositionX.SetNumUninitialized(count, false);
+	PositionY.SetNumUninitialized(count, false);
+	PositionZ.SetNumUninitialized(count, false);
+	ForceX.SetNumUninitialized(count, false);
+	ForceY.SetNumUninitialized(count, false);
+	ForceZ.SetNumUninitialized(count, false);
+	FMemory::Memzero(ForceX.GetData(), count * sizeof(float));
+	FMemory::Memzero(ForceY.GetData(), count * sizeof(float));
+	FMemory::Memzero(ForceZ.GetData(), count * sizeof(float));
+
+	for (int32 i = 0; i < count; ++i)
+	{
+		const FVector location = Bodies[i].Actor->GetActorLocation();
+		PositionX[i] = location.X;
+		PositionY[i] = location.Y;
+		PositionZ[i] = location.Z;
+	}
+
+	EvaluateFields(Fields, count, PositionX.GetData(), PositionY.GetData(), PositionZ.GetData(), ForceX.GetData(), ForceY.GetData(), ForceZ.GetData());
+
+	// Apply the summed forces, only touching bodies that are or were inside a field
+	ForcesApplied = false;
+	for (int32 i = 0; i < count; ++i)
+	{
+		FForceFieldBody& body = Bodies[i];
+		const FVector force(ForceX[i], ForceY[i], ForceZ[i]);
+		const bool has_force = !force.IsNearlyZero();
+
+		if (has_force || body.HasForce)
+		{
+			if (body.Physics != nullptr)
+			{
+				if (has_force)
+				{
+					body.Physics->AddStaticForce(force);
+				}
+				else
+				{
+					body.Physics->ResetStaticForce();
+				}
+			}
+			else if (has_force)
+			{
+				body.Projectile->SetStaticForce(force);
+			}
+			else
+			{
+				body.Projectile->ResetStaticForce();
+			}
+		}
+
+		body.HasForce = has_force;
+		ForcesApplied |= has_force;
+	}
+}
+
+ETickableTickType UForceFieldSubsystem::GetTickableTickType() const
+{
+	// Don't tick the class default object
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UForceFieldSubsystem::IsTickable() const
+{
+	return Bodies.Num() > 0 && (Fields.Num() > 0 || ForcesApplied);
+}
+
+TStatId UForceFieldSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UForceFieldSubsystem, STATGROUP_Tickables);
+}
+
+UWorld* UForceFieldSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+/// Field Functions ///
+
+void UForceFieldSubsystem::SetField(const FForceField& Field)
+{
+	for (FForceField& field : Fields)
+	{
+		if (field.Owner == Field.Owner)
+		{
+			field = Field;
+			return;
+		}
+	}
+
+	Fields.Add(Field);
+}
+
+void UForceFieldSubsystem::RemoveField(const UObject* Owner)
+{
+	Fields.RemoveAllSwap([Owner](const FForceField& Field) { return Field.Owner == Owner; });
+}
+
+void UForceFieldSubsystem::RegisterBody(AActor* Actor)
+{
+	if (Actor == nullptr || BodyIndices.Contains(Actor))
+		return;
+
+	FForceFieldBody body;
+	body.Actor = Actor;
+	body.Physics = Cast<IPhysicsInterface>(Actor);
+	if (body.Physics == nullptr)
+	{
+		body.Projectile = Cast<ACyberShooterProjectile>(Actor);
+		if (body.Projectile == nullptr)
+			return;
+	}
+
+	BodyIndices.Add(Actor, Bodies.Add(body));
+}
+
+void UForceFieldSubsystem::UnregisterBody(AActor* Actor)
+{
+	int32 index;
+	if (!BodyIndices.RemoveAndCopyValue(Actor, index))
+		return;
+
+	// Swap the last body into the removed body's place
+	Bodies.RemoveAtSwap(index, 1, false);
+	if (index < Bodies.Num())
+	{
+		BodyIndices[Bodies[index].Actor] = index;
+	}
+}
+
+void UForceFieldSubsystem::EvaluateFields(const TArray<FForceField>& InFields, int32 Count, const float* X, const float* Y, const float* Z, float* OutX, float* OutY, float* OutZ)
+{
+	// Walk each field over every body so the inner loops are branch free and can be vectorized
+	for (const FForceField& field : InFields)
+	{
+		const float center_x = field.Center.X;
+		const float center_y = field.Center.Y;
+		const float center_z = field.Center.Z;
+
+		if (field.Type == EForceFieldType::Radial)
+		{
+			const float radius_squared = field.Radius * field.Radius;
+			const float strength = field.Strength;
+
+			for (int32 i = 0; i < Count; ++i)
+			{
+				const float dx = center_x - X[i];
+				const float dy = center_y - Y[i];
+				const float dz = center_z - Z[i];
+				const float distance_squared = dx * dx + dy * dy + dz * dz;
+
+				// Bodies at the exact center get no direction and no force
+				const float scale = (distance_squared <= radius_squared && distance_squared > SMALL_NUMBER) ? strength * FMath::InvSqrt(FMath::Max(distance_squared, SMALL_NUMBER)) : 0.0f;
+				OutX[i] += dx * scale;
+				OutY[i] += dy * scale;
+				OutZ[i] += dz * scale;
+			}
+		}
+		else
+		{
+			// Project each body onto the box axes to test it against the extent
+			const FVector axis_x = field.Rotation.GetAxisX();
+			const FVector axis_y = field.Rotation.GetAxisY();
+			const FVector axis_z = field.Rotation.GetAxisZ();
+			const FVector extent = field.Extent;
+			const FVector force = field.Force;
+
+			for (int32 i = 0; i < Count; ++i)
+			{
+				const float dx = X[i] - center_x;
+				const float dy = Y[i] - center_y;
+				const float dz = Z[i] - center_z;
+				const float local_x = dx * axis_x.X + dy * axis_x.Y + dz * axis_x.Z;
+				const float local_y = dx * axis_y.X + dy * axis_y.Y + dz * axis_y.Z;
+				const float local_z = dx * axis_z.X + dy * axis_z.Y + dz * axis_z.Z;
+
+				const float inside = (FMath::Abs(local_x) <= extent.X && FMath::Abs(local_y) <= extent.Y && FMath::Abs(local_z) <= extent.Z) ? 1.0f : 0.0f;
+				OutX[i] += force.X * inside;
+				OutY[i] += force.Y * inside;
+				OutZ[i] += force.Z * inside;
+			}
+		}
+	}
+}
@@ -0,0 +1,116 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "ForceFieldSubsystem.generated.h"
+
+class IPhysicsInterface;
+class ACyberShooterProjectile;
+
+// The shapes a force field can have
+enum class EForceFieldType : uint8
+{
+	// Pulls bodies inside a sphere towards its center, or pushes them away with a negative strength
+	Radial,
+	// Pushes bodies inside a box in a fixed direction
+	Directional
+};
+
+// An analytic force field evaluated against every physics body each frame
+struct FForceField
+{
+	FForceField() : Owner(nullptr), Type(EForceFieldType::Radial), Center(0.0f), Radius(0.0f), Rotation(FQuat::Identity), Extent(0.0f), Strength(0.0f), Force(0.0f) {}
+
+	// The actor that registered the field
+	const UObject* Owner;
+	EForceFieldType Type;
+
+	// The center of the field's bounds
+	FVector Center;
+	// The radius of a radial field
+	float Radius;
+	// The rotation and half size of a directional field's box
+	FQuat Rotation;
+	FVector Extent;
+
+	// The force a radial field applies towards its center
+	float Strength;
+	// The force a directional field applies
+	FVector Force;
+};
+
+// A body that receives force from the fields
+struct FForceFieldBody
+{
+	FForceFieldBody() : Actor(nullptr), Physics(nullptr), Projectile(nullptr), HasForce(false) {}
+
+	AActor* Actor;
+	// Set for physics objects and pawns
+	IPhysicsInterface* Physics;
+	// Set for projectiles
+	ACyberShooterProjectile* Projectile;
+	// Set to true if a field force was applied to the body on the last update
+	bool HasForce;
+};
+
+// Sums the static forces of every force field for every physics body in one pass per frame
+// Fields are evaluated analytically against packed body positions so gadgets don't need overlap events or ticks, and overlapping fields add together
+UCLASS()
+class CYBERSHOOTER_API UForceFieldSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UForceFieldSubsystem();
+
+	virtual void Deinitialize() override;
+
+	/// FTickableGameObject ///
+
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	/// Field Functions ///
+
+	// Add a field, replacing any field with the same owner
+	void SetField(const FForceField& Field);
+	// Remove the field added by an owner
+	void RemoveField(const UObject* Owner);
+
+	// Add an actor that implements IPhysicsInterface or a projectile to the bodies affected by fields
+	void RegisterBody(AActor* Actor);
+	// Remove a body, the body keeps any field force applied to it
+	void UnregisterBody(AActor* Actor);
+
+	// Add the force from every field to the force arrays for Count positions
+	static void EvaluateFields(const TArray<FForceField>& InFields, int32 Count, const float* X, const float* Y, const float* Z, float* OutX, float* OutY, float* OutZ);
+
+	FORCEINLINE int32 GetNumFields() const { return Fields.Num(); }
+	FORCEINLINE int32 GetNumBodies() const { return Bodies.Num(); }
+
+protected:
+	// The registered fields
+	TArray<FForceField> Fields;
+
+	// The bodies affected by fields
+	TArray<FForceFieldBody> Bodies;
+	// The index of each body in Bodies
+	TMap<AActor*, int32> BodyIndices;
+
+	// Packed body positions and summed forces
+	TArray<float> PositionX;
+	TArray<float> PositionY;
+	TArray<float> PositionZ;
+	TArray<float> ForceX;
+	TArray<float> ForceY;
+	TArray<float> ForceZ;
+
+	// Set to true while any body has a field force applied, so removing the last field still clears the forces
+	bool ForcesApplied;
+};
@@ -0,0 +1,104 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#include "GameplayLog.h"
+#include "CyberShooter.h"
+
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY(LogCyberShooterCombat)
+DEFINE_LOG_CATEGORY(LogCyberShooterAggro)
+DEFINE_LOG_CATEGORY(LogCyberShooterLevel)
+DEFINE_LOG_CATEGORY(LogCyberShooterSave)
+DEFINE_LOG_CATEGORY(LogCyberShooterMenu)
+
+#if CYBERSHOOTER_GAMEPLAY_LOG
+
+// The number of events kept by the log, must be a power of two
+static const int32 GameplayEventCapacity = 1024;
+
+static FGameplayEvent GameplayEvents[GameplayEventCapacity];
+// The total number of events recorded, the newest event is at (GameplayEventCount - 1) in the ring
+static uint32 GameplayEventCount = 0;
+
+static TAutoConsoleVariable<int32> CVarGameplayLog(
+	TEXT("cs.GameplayLog"),
+	1,
+	TEXT("How gameplay events are reported.\n")
+	TEXT("0: Don't record events\n")
+	TEXT("1: Record events in the event buffer\n")
+	TEXT("2: Also print events to the output log\n")
+	TEXT("3: Also show events on screen"),
+	ECVF_Default);
+
+static FAutoConsoleCommand DumpGameplayLogCommand(
+	TEXT("cs.DumpGameplayLog"),
+	TEXT("Write the gameplay event buffer to a file in the log directory. Takes an optional file name."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const FString file_name = Args.Num() > 0 ? Args[0] : TEXT("GameplayEvents.log");
+		if (FGameplayEventLog::Dump(file_name))
+		{
+			UE_LOG(LogCyberShooter, Log, TEXT("Gameplay events written to %s"), *file_name);
+		}
+		else
+		{
+			UE_LOG(LogCyberShooter, Warning, TEXT("Unable to write gameplay events to %s"), *file_name);
+		}
+	}));
+
+void FGameplayEventLog::Add(const FLogCategoryBase& Category, const TCHAR* Event, FName Subject, const FColor& Color)
+{
+	const int32 verbosity = GetVerbosity();
+	if (verbosity <= 0)
+		return;
+
+	FGameplayEvent& entry = GameplayEvents[GameplayEventCount & (GameplayEventCapacity - 1)];
+	entry.Time = FPlatformTime::Seconds();
+	entry.Category = Category.GetCategoryName();
+	entry.Event = Event;
+	entry.Subject = Subject;
+	GameplayEventCount++;
+
+	if (verbosity >= 2 && !Category.IsSuppressed(ELogVerbosity::Log))
+	{
+		FMsg::Logf(__FILE__, __LINE__, entry.Category, ELogVerbosity::Log, TEXT("%s %s"), Event, *Subject.ToString());
+	}
+	if (verbosity >= 3 && GEngine != nullptr)
+	{
+		GEngine->AddOnScreenDebugMessage(-1, 3.0f, Color, FString(Event) + TEXT(" ") + Subject.ToString());
+	}
+}
+
+bool FGameplayEventLog::Dump(const FString& FileName)
+{
+	const uint32 count = FMath::Min<uint32>(GameplayEventCount, GameplayEventCapacity);
+
+	FString text;
+	for (uint32 i = GameplayEventCount - count; i != GameplayEventCount; ++i)
+	{
+		text += ToString(GameplayEvents[i & (GameplayEventCapacity - 1)]);
+		text += LINE_TERMINATOR;
+	}
+
+	return FFileHelper::SaveStringToFile(text, *FPaths::Combine(FPaths::ProjectLogDir(), FileName));
+}
+
+void FGameplayEventLog::Reset()
+{
+	GameplayEventCount = 0;
+}
+
+int32 FGameplayEventLog::GetVerbosity()
+{
+	return CVarGameplayLog.GetValueOnGameThread();
+}
+
+FString FGameplayEventLog::ToString(const FGameplayEvent& Entry)
+{
+	return FString::Printf(TEXT("%.3f %s: %s %s"), Entry.Time, *Entry.Category.ToString(), Entry.Event, *Entry.Subject.ToString());
+}
+
+#endif
@@ -0,0 +1,61 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Gameplay events are only recorded in development builds
+#define CYBERSHOOTER_GAMEPLAY_LOG !(UE_BUILD_SHIPPING || UE_BUILD_TEST)
+
+DECLARE_LOG_CATEGORY_EXTERN(LogCyberShooterCombat, Log, All);
+DECLARE_LOG_CATEGORY_EXTERN(LogCyberShooterAggro, Log, All);
+DECLARE_LOG_CATEGORY_EXTERN(LogCyberShooterLevel, Log, All);
+DECLARE_LOG_CATEGORY_EXTERN(LogCyberShooterSave, Log, All);
+DECLARE_LOG_CATEGORY_EXTERN(LogCyberShooterMenu, Log, All);
+
+#if CYBERSHOOTER_GAMEPLAY_LOG
+
+// An event stored in the gameplay event log
+struct FGameplayEvent
+{
+	FGameplayEvent() : Time(0.0), Event(nullptr) {}
+
+	// The platform time the event happened at
+	double Time;
+	// The log category the event belongs to
+	FName Category;
+	// A description of the event, always a string literal
+	const TCHAR* Event;
+	// The name of the object or level the event happened to
+	FName Subject;
+};
+
+// A fixed size ring buffer of recent gameplay events
+// Recording an event only copies names and a literal, strings are built when the log is printed or dumped
+class CYBERSHOOTER_API FGameplayEventLog
+{
+public:
+	// Record an event, then print it to the output log or screen depending on cs.GameplayLog
+	static void Add(const FLogCategoryBase& Category, const TCHAR* Event, FName Subject, const FColor& Color);
+
+	// Write the buffered events to a file in the project's log directory, oldest first
+	static bool Dump(const FString& FileName);
+	// Remove every buffered event
+	static void Reset();
+
+	// Get the current cs.GameplayLog level
+	static int32 GetVerbosity();
+
+private:
+	// Format an event as a line of text
+	static FString ToString(const FGameplayEvent& Entry);
+};
+
+// Record a gameplay event with a literal description and the FName of its subject
+#define GAMEPLAY_EVENT(Category, Event, Subject, Color) FGameplayEventLog::Add(Category, TEXT(Event), Subject, Color)
+
+#else
+
+#define GAMEPLAY_EVENT(Category, Event, Subject, Color)
+
+#endif
@@ -3,9 +3,11 @@
 #include "LevelTrigger.h"
 #include "CyberShooterPlayer.h"
 #include "CyberShooterGameInstance.h"
+#include "ActorRegistrySubsystem.h"
+#include "AggroZone.h"
 
 #include "Kismet/GameplayStatics.h"
-#include "Engine/Engine.h"
+#include "Engine/World.h"
 
 #if WITH_EDITOR
 #include "Components/ArrowComponent.h"
@@ -38,6 +40,64 @@ ALevelTrigger::ALevelTrigger()
 	// Set defaults
 	TargetLevel = NAME_None;
 	TriggerID = 0;
+	PreloadRadius = 3000.0f;
+	PreloadZone = nullptr;
+	WaitForExit = false;
+}
+
+void ALevelTrigger::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (TargetLevel.IsNone())
+		return;
+
+	if (PreloadZone != nullptr)
+	{
+		PreloadZone->OnEnter.AddDynamic(this, &ALevelTrigger::Preload);
+	}
+
+	// Check the player's distance a few times a second instead of ticking
+	if (PreloadRadius > 0.0f)
+	{
+		UCyberShooterGameInstance* instance = Cast<UCyberShooterGameInstance>(GetWorld()->GetGameInstance());
+		WaitForExit = instance != nullptr && instance->LocationID == (int32)TriggerID;
+
+		UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+		if (timers != nullptr)
+		{
+			timers->SetTimer(TimerHandle_PreloadTimer, this, &ALevelTrigger::CheckPreloadRadius, 0.25f, true);
+		}
+	}
+}
+
+void ALevelTrigger::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// Add the actor to the world's registry
+	UActorRegistrySubsystem* registry = GetWorld()->GetSubsystem<UActorRegistrySubsystem>();
+	if (registry != nullptr)
+	{
+		registry->Register(this);
+	}
+}
+
+void ALevelTrigger::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UActorRegistrySubsystem* registry = GetWorld()->GetSubsystem<UActorRegistrySubsystem>();
+	if (registry != nullptr)
+	{
+		registry->Unregister(this);
+	}
+
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers != nullptr)
+	{
+		timers->ClearTimer(TimerHandle_PreloadTimer);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void ALevelTrigger::BeginOverlap(AActor* OverlappedActor, AActor* OtherActor)
@@ -58,12 +118,46 @@ void ALevelTrigger::BeginOverlap(AActor* OverlappedActor, AActor* OtherActor)
 			{
 				instance->LocationID = TriggerID;
 				instance->SavePlayer();
+
+				// Switch levels
+				instance->TravelToLevel(TargetLevel);
 			}
+			else
+			{
+				UGameplayStatics::OpenLevel(GetWorld(), TargetLevel);
+			}
+		}
+	}
+}
 
-			GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Yellow, "Loading level: " + TargetLevel.ToString());
+void ALevelTrigger::Preload()
+{
+	UCyberShooterGameInstance* instance = Cast<UCyberShooterGameInstance>(GetWorld()->GetGameInstance());
+	if (instance != nullptr)
+	{
+		instance->PreloadLevel(TargetLevel);
+	}
 
-			// Switch levels
-			UGameplayStatics::OpenLevel(GetWorld(), TargetLevel);
-		}
+	// The level only needs to be requested once
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers != nullptr)
+	{
+		timers->ClearTimer(TimerHandle_PreloadTimer);
+	}
+}
+
+void ALevelTrigger::CheckPreloadRadius()
+{
+	ACyberShooterPlayer* player = UActorRegistrySubsystem::FindPlayer(this);
+	if (player == nullptr)
+		return;
+
+	if (FVector::DistSquared(player->GetActorLocation(), GetActorLocation()) > FMath::Square(PreloadRadius))
+	{
+		WaitForExit = false;
+	}
+	else if (!WaitForExit)
+	{
+		Preload();
 	}
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "TimingWheelSubsystem.h"
+
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "LevelTrigger.generated.h"
@@ -19,12 +21,20 @@ class CYBERSHOOTER_API ALevelTrigger : public AActor
 public:	
 	ALevelTrigger();
 
+	virtual void BeginPlay() override;
+	virtual void PostInitializeComponents() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	FORCEINLINE uint32 GetID() const { return TriggerID; }
 
 protected:
 	// Change levels when the player overlaps the trigger
 	UFUNCTION()
 		void BeginOverlap(AActor* OverlappedActor, AActor* OtherActor);
+	// Start loading the target level in the background
+	UFUNCTION()
+		void Preload();
+	// Preload the target level if the player is within the preload radius
+	void CheckPreloadRadius();
 
 	// The level the trigger will switch to
 	UPROPERTY(EditAnywhere)
@@ -33,6 +43,19 @@ protected:
 	UPROPERTY(EditAnywhere)
 		uint32 TriggerID;
 
+	// The target level starts loading when the player comes within this distance, zero to only preload from the zone
+	UPROPERTY(Category = "Preload", EditAnywhere)
+		float PreloadRadius;
+	// The target level starts loading when the player enters this zone
+	UPROPERTY(Category = "Preload", EditInstanceOnly)
+		class AAggroZone* PreloadZone;
+
+	// Set when the player arrived through this trigger, the level behind it isn't preloaded until the player has left the radius
+	bool WaitForExit;
+
+	// The timer handle for checking the player's distance
+	FWheelTimerHandle TimerHandle_PreloadTimer;
+
 #if WITH_EDITORONLY_DATA
 	// Arrow indicating the forward orientation vector
 	UPROPERTY(Category = "Components", EditAnywhere)
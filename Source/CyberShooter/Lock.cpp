@@ -2,6 +2,8 @@
 
 #include "Lock.h"
 #include "CyberShooterGameInstance.h"
+#include "ActorRegistrySubsystem.h"
+#include "GameplayLog.h"
 
 #include "Kismet/GameplayStatics.h"
 
@@ -18,6 +20,29 @@ ALock::ALock()
 	ID = 0;
 }
 
+void ALock::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// Add the actor to the world's registry
+	UActorRegistrySubsystem* registry = GetWorld()->GetSubsystem<UActorRegistrySubsystem>();
+	if (registry != nullptr)
+	{
+		registry->Register(this);
+	}
+}
+
+void ALock::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UActorRegistrySubsystem* registry = GetWorld()->GetSubsystem<UActorRegistrySubsystem>();
+	if (registry != nullptr)
+	{
+		registry->Unregister(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void ALock::BeginPlay()
 {
 	Super::BeginPlay();
@@ -40,9 +65,7 @@ void ALock::Tick(float DeltaSeconds)
 	{
 		OnUnlock.Broadcast();
 
-		FString msg("Unlocked ");
-		msg.Append(GetName());
-		GEngine->AddOnScreenDebugMessage(-1, 5.0f, FColor::Cyan, msg);
+		GAMEPLAY_EVENT(LogCyberShooterLevel, "Unlocked", GetFName(), FColor::Cyan);
 	}
 
 	// Stop ticking
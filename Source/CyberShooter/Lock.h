@@ -18,6 +18,8 @@ public:
 	ALock();
 
 	virtual void BeginPlay() override;
+	virtual void PostInitializeComponents() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaSeconds) override;
 
 	/// Blueprint Events ///
@@ -35,6 +37,8 @@ public:
 	UFUNCTION(BlueprintCallable)
 		void Lock();
 
+	FORCEINLINE int32 GetID() const { return ID; }
+
 protected:
 	/// Properties ///
 	
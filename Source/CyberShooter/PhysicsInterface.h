@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "PhysicsModifierStack.h"
+
 #include "CoreMinimal.h"
 #include "UObject/Interface.h"
 #include "PhysicsInterface.generated.h"
@@ -45,35 +47,10 @@ public:
 	UFUNCTION()
 		virtual void ResetStaticForce() = 0;
 
-	// Change the gravity applied to an object
-	UFUNCTION()
-		virtual void SetGravity(float NewGravity) = 0;
-	// Reset gravity to the world's default
-	UFUNCTION()
-		virtual void ResetGravity() = 0;
-	// Change air friction
-	UFUNCTION()
-		virtual void SetAirFriction(float NewFriction) = 0;
-	// Reset air friction to the world default
-	UFUNCTION()
-		virtual void ResetAirFriction() = 0;
-	// Set global friction
-	UFUNCTION()
-		virtual void SetFriction(float NewFriction) = 0;
-	// Reset global friction to world default
-	UFUNCTION()
-		virtual void ResetFriction() = 0;
-
-	// Multiply the mass of the object
-	UFUNCTION()
-		virtual void SetMass(float Multiplier) = 0;
-	// Reset the object's mass
-	UFUNCTION()
-		virtual void ResetMass() = 0;
-
-	// Change the multiplier for ticks
-	UFUNCTION()
-		virtual void SetTickRate(float NewRate) = 0;
+	// Apply a zone's changes to gravity, friction, mass, force and tick rate, replacing any changes the zone already applied
+	virtual void AddPhysicsModifier(const FPhysicsModifier& Modifier) = 0;
+	// Remove the changes applied by a zone
+	virtual void RemovePhysicsModifier(const UObject* Source) = 0;
 
 	// Get the mass of the object
 	UFUNCTION()
@@ -0,0 +1,79 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#include "PhysicsModifierStack.h"
+
+FPhysicsModifierStack::FPhysicsModifierStack()
+{
+	BaseGravity = 1000.0f;
+	BaseAirFriction = 0.5f;
+	BaseSet = false;
+
+	Recompute();
+}
+
+void FPhysicsModifierStack::SetBase(float NewGravity, float NewAirFriction)
+{
+	BaseGravity = NewGravity;
+	BaseAirFriction = NewAirFriction;
+	BaseSet = true;
+
+	Recompute();
+}
+
+void FPhysicsModifierStack::Add(const FPhysicsModifier& Modifier)
+{
+	// Re-entering a zone moves it back to the top
+	Modifiers.RemoveAll([&Modifier](const FPhysicsModifier& Entry) { return Entry.Source == Modifier.Source; });
+	Modifiers.Add(Modifier);
+
+	Recompute();
+}
+
+bool FPhysicsModifierStack::Remove(const UObject* Source)
+{
+	if (Modifiers.RemoveAll([Source](const FPhysicsModifier& Entry) { return Entry.Source == Source; }) == 0)
+		return false;
+
+	Recompute();
+	return true;
+}
+
+void FPhysicsModifierStack::Empty()
+{
+	Modifiers.Reset();
+
+	Recompute();
+}
+
+void FPhysicsModifierStack::Recompute()
+{
+	Gravity = BaseGravity;
+	Friction = 1.0f;
+	AirFriction = BaseAirFriction;
+	Mass = 1.0f;
+	Force = FVector(0.0f);
+	TickRate = 1.0f;
+
+	// Walk from the bottom so later modifiers override earlier ones
+	for (const FPhysicsModifier& modifier : Modifiers)
+	{
+		if (modifier.AffectGravity)
+		{
+			Gravity = modifier.Gravity;
+		}
+		if (modifier.AffectFriction)
+		{
+			Friction = modifier.Friction;
+			AirFriction = modifier.AirFriction;
+		}
+		if (modifier.Mass != 1.0f)
+		{
+			Mass = modifier.Mass;
+		}
+		if (modifier.TickRate != 1.0f && modifier.TickRate > 0.0f)
+		{
+			TickRate = modifier.TickRate;
+		}
+		Force += modifier.Force;
+	}
+}
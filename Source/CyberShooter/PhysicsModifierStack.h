@@ -0,0 +1,78 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// The physics changes a zone applies to the bodies inside it
+struct FPhysicsModifier
+{
+	FPhysicsModifier() : Source(nullptr), AffectGravity(false), Gravity(1000.0f), AffectFriction(false), Friction(1.0f), AirFriction(0.5f), Mass(1.0f), Force(0.0f), TickRate(1.0f) {}
+
+	// The zone applying the modifier, used to find the modifier again when the body leaves the zone
+	const UObject* Source;
+
+	// Set to true if the modifier replaces gravity
+	bool AffectGravity;
+	float Gravity;
+	// Set to true if the modifier replaces surface and air friction
+	bool AffectFriction;
+	float Friction;
+	float AirFriction;
+
+	// The mass multiplier, ignored if set to 1
+	float Mass;
+	// A static force added to the body, forces from every modifier are summed
+	FVector Force;
+	// The tick speed multiplier, ignored if set to 1
+	float TickRate;
+};
+
+// The modifiers applied to a physics body, with the effective values cached so they are only recomputed when a modifier is added or removed
+// The most recently added modifier that changes a value wins, so leaving a zone restores the value of the zone around it
+class CYBERSHOOTER_API FPhysicsModifierStack
+{
+public:
+	FPhysicsModifierStack();
+
+	// Set the world gravity and air friction used when no modifier changes them
+	void SetBase(float NewGravity, float NewAirFriction);
+
+	// Add a modifier on top of the stack, replacing any modifier from the same source
+	void Add(const FPhysicsModifier& Modifier);
+	// Remove the modifier from a source, returns true if the stack changed
+	bool Remove(const UObject* Source);
+	// Remove every modifier
+	void Empty();
+
+	/// Accessors ///
+
+	FORCEINLINE bool HasBase() const { return BaseSet; }
+	FORCEINLINE int32 Num() const { return Modifiers.Num(); }
+	FORCEINLINE float GetGravity() const { return Gravity; }
+	FORCEINLINE float GetFriction() const { return Friction; }
+	FORCEINLINE float GetAirFriction() const { return AirFriction; }
+	FORCEINLINE float GetMass() const { return Mass; }
+	FORCEINLINE const FVector& GetForce() const { return Force; }
+	FORCEINLINE float GetTickRate() const { return TickRate; }
+
+private:
+	// Rebuild the effective values from the base values and the modifiers
+	void Recompute();
+
+	// The modifiers in the order they were added
+	TArray<FPhysicsModifier, TInlineAllocator<4>> Modifiers;
+
+	// The world values
+	float BaseGravity;
+	float BaseAirFriction;
+	bool BaseSet;
+
+	// The effective values
+	float Gravity;
+	float Friction;
+	float AirFriction;
+	float Mass;
+	FVector Force;
+	float TickRate;
+};
@@ -0,0 +1,90 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#include "PhysicsModifierStack.h"
+#include "CyberShooter.h"
+
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPhysicsModifierStackNestingTest, "CyberShooter.PhysicsModifierStack.Nesting", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPhysicsModifierStackNestingTest::RunTest(const FString& Parameters)
+{
+	UObject* outer_zone = NewObject<UObject>(GetTransientPackage());
+	UObject* inner_zone = NewObject<UObject>(GetTransientPackage());
+
+	// The outer zone changes gravity and friction and pushes up
+	FPhysicsModifier outer;
+	outer.Source = outer_zone;
+	outer.AffectGravity = true;
+	outer.Gravity = 500.0f;
+	outer.AffectFriction = true;
+	outer.Friction = 0.2f;
+	outer.AirFriction = 0.1f;
+	outer.Force = FVector(0.0f, 0.0f, 100.0f);
+
+	// The inner zone only changes gravity and pushes forward
+	FPhysicsModifier inner;
+	inner.Source = inner_zone;
+	inner.AffectGravity = true;
+	inner.Gravity = 2000.0f;
+	inner.Force = FVector(100.0f, 0.0f, 0.0f);
+
+	FPhysicsModifierStack stack;
+	stack.SetBase(1000.0f, 0.5f);
+
+	// Enter the outer zone, then the inner zone, leaving in the same order
+	stack.Add(outer);
+	TestEqual(TEXT("Enter outer: gravity"), stack.GetGravity(), 500.0f);
+	TestEqual(TEXT("Enter outer: friction"), stack.GetFriction(), 0.2f);
+	TestEqual(TEXT("Enter outer: air friction"), stack.GetAirFriction(), 0.1f);
+	TestEqual(TEXT("Enter outer: force"), stack.GetForce(), FVector(0.0f, 0.0f, 100.0f));
+
+	stack.Add(inner);
+	TestEqual(TEXT("Enter inner: gravity"), stack.GetGravity(), 2000.0f);
+	TestEqual(TEXT("Enter inner: friction"), stack.GetFriction(), 0.2f);
+	TestEqual(TEXT("Enter inner: air friction"), stack.GetAirFriction(), 0.1f);
+	TestEqual(TEXT("Enter inner: force"), stack.GetForce(), FVector(100.0f, 0.0f, 100.0f));
+
+	TestTrue(TEXT("Leave outer: removed"), stack.Remove(outer_zone));
+	TestEqual(TEXT("Leave outer: gravity"), stack.GetGravity(), 2000.0f);
+	TestEqual(TEXT("Leave outer: friction"), stack.GetFriction(), 1.0f);
+	TestEqual(TEXT("Leave outer: air friction"), stack.GetAirFriction(), 0.5f);
+	TestEqual(TEXT("Leave outer: force"), stack.GetForce(), FVector(100.0f, 0.0f, 0.0f));
+
+	TestTrue(TEXT("Leave inner: removed"), stack.Remove(inner_zone));
+	TestEqual(TEXT("Leave inner: gravity"), stack.GetGravity(), 1000.0f);
+	TestEqual(TEXT("Leave inner: friction"), stack.GetFriction(), 1.0f);
+	TestEqual(TEXT("Leave inner: air friction"), stack.GetAirFriction(), 0.5f);
+	TestEqual(TEXT("Leave inner: force"), stack.GetForce(), FVector(0.0f));
+	TestEqual(TEXT("Leave inner: empty"), stack.Num(), 0);
+
+	// Leave the inner zone first, the outer zone's values come back
+	stack.Add(outer);
+	stack.Add(inner);
+	stack.Remove(inner_zone);
+	TestEqual(TEXT("Leave inner first: gravity"), stack.GetGravity(), 500.0f);
+	TestEqual(TEXT("Leave inner first: friction"), stack.GetFriction(), 0.2f);
+	TestEqual(TEXT("Leave inner first: force"), stack.GetForce(), FVector(0.0f, 0.0f, 100.0f));
+
+	stack.Remove(outer_zone);
+	TestEqual(TEXT("Leave outer last: gravity"), stack.GetGravity(), 1000.0f);
+	TestEqual(TEXT("Leave outer last: friction"), stack.GetFriction(), 1.0f);
+	TestFalse(TEXT("Leaving a zone twice changes nothing"), stack.Remove(outer_zone));
+
+	// Re-entering a zone moves it back on top of the zones it was under
+	stack.Add(outer);
+	stack.Add(inner);
+	stack.Add(outer);
+	TestEqual(TEXT("Re-enter outer: gravity"), stack.GetGravity(), 500.0f);
+	TestEqual(TEXT("Re-enter outer: modifiers"), stack.Num(), 2);
+
+	outer_zone->MarkPendingKill();
+	inner_zone->MarkPendingKill();
+
+	return true;
+}
+
+#endif
@@ -109,15 +109,20 @@ void UPhysicsMovementComponent::SetVelocity(FVector NewVelocity)
 }
 
 void UPhysicsMovementComponent::Impact(IPhysicsInterface* OtherObject, FVector ImpactNormal)
+{
+	Impact(OtherObject, ImpactNormal, GetTotalVelocity(), OtherObject->GetVelocity());
+}
+
+void UPhysicsMovementComponent::Impact(IPhysicsInterface* OtherObject, FVector ImpactNormal, FVector ApproachVelocity, FVector OtherApproachVelocity)
 {
 	if (!Disabled && OtherObject->CanMove())
 	{
 		// Make sure this object is the one causing the impact
-		if (FVector::DotProduct(GetTotalVelocity().GetSafeNormal(), ImpactNormal) < 0.0f)
+		if (FVector::DotProduct(ApproachVelocity.GetSafeNormal(), ImpactNormal) < 0.0f)
 		{
 			Wake();
-			FVector v1 = GetTotalVelocity();
-			FVector v2 = OtherObject->GetVelocity();
+			FVector v1 = ApproachVelocity;
+			FVector v2 = OtherApproachVelocity;
 
 			// Calculate velocity along the normal of the impact
 			float a1 = FVector::DotProduct(v1, ImpactNormal);
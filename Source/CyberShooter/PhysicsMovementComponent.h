@@ -57,6 +57,8 @@ public:
 	void SetVelocity(FVector NewVelocity);
 	// Impact with a physics object
 	void Impact(IPhysicsInterface* OtherObject, FVector ImpactNormal);
+	// Impact with a physics object using the velocities both objects had when they met
+	void Impact(IPhysicsInterface* OtherObject, FVector ImpactNormal, FVector ApproachVelocity, FVector OtherApproachVelocity);
 	// Teleport the object to a new location
 	void Teleport(FVector Location);
 	
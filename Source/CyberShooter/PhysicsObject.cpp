@@ -4,6 +4,10 @@
 #include "PhysicsMovementComponent.h"
 #include "CyberShooterPlayer.h"
 #include "CyberShooterGameInstance.h"
+#include "ContactSubsystem.h"
+#include "ActorRegistrySubsystem.h"
+#include "ForceFieldSubsystem.h"
+#include "CyberShooter.h"
 
 #include "Kismet/KismetMathLibrary.h"
 #include "Kismet/GameplayStatics.h"
@@ -34,10 +38,10 @@ APhysicsObject::APhysicsObject()
 	RespawnDuration = 2.0f;
 	RespawnCooldown = 2.0f;
 	BlinkRate = 20;
-	RespawnTimer = 0;
 	StartLocked = false;
 
-	PrimaryActorTick.bCanEverTick = true;
+	// Respawning runs on the timing wheel, so only subclasses need to tick
+	PrimaryActorTick.bCanEverTick = false;
 }
 
 void APhysicsObject::BeginPlay()
@@ -56,9 +60,19 @@ void APhysicsObject::BeginPlay()
 	RespawnPoint = GetActorLocation();
 
 	// Set world physics
-	ResetGravity();
-	ResetAirFriction();
-	ResetMass();
+	UCyberShooterGameInstance* instance = Cast<UCyberShooterGameInstance>(GetWorld()->GetGameInstance());
+	if (instance != nullptr)
+	{
+		PhysicsModifiers.SetBase(instance->GetGravity(), instance->GetAirFriction());
+	}
+	ApplyPhysicsModifiers();
+
+	// Receive the static forces of force fields
+	UForceFieldSubsystem* fields = GetWorld()->GetSubsystem<UForceFieldSubsystem>();
+	if (fields != nullptr)
+	{
+		fields->RegisterBody(this);
+	}
 
 	// Lock the object
 	if (StartLocked)
@@ -67,39 +81,15 @@ void APhysicsObject::BeginPlay()
 	}
 }
 
-void APhysicsObject::Tick(float DeltaSeconds)
+void APhysicsObject::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	// Manage respawning
-	if (RespawnTimer > 0.0f)
+	UForceFieldSubsystem* fields = GetWorld()->GetSubsystem<UForceFieldSubsystem>();
+	if (fields != nullptr)
 	{
-		RespawnTimer -= DeltaSeconds;
-
-		// Blink
-		int state = (int)(RespawnTimer * BlinkRate) & 2;
-		SetActorHiddenInGame((bool)state);
-
-		// End the respawn sequence
-		if (RespawnTimer <= 0.0f)
-		{
-			if (Respawned)
-			{
-				// Check for collisions inside the object to ensure it doesn't respawn inside another object
-				FHitResult hit;
-				if (GetWorld()->SweepSingleByChannel(hit, GetActorLocation(), GetActorLocation(), GetActorQuat(), GetStaticMeshComponent()->GetCollisionObjectType(), GetStaticMeshComponent()->GetCollisionShape()))
-				{
-					RespawnTimer = RespawnCooldown;
-				}
-				else
-				{
-					CancelRespawn();
-				}
-			}
-			else
-			{
-				Respawn();
-			}
-		}
+		fields->UnregisterBody(this);
 	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 FVector APhysicsObject::GetVelocity() const
@@ -108,6 +98,14 @@ FVector APhysicsObject::GetVelocity() const
 }
 
 void APhysicsObject::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
+{
+	// Contacts are resolved once per frame by the contact subsystem
+	UContactSubsystem::ReportHit(this, HitComp, OtherActor, OtherComp, Hit);
+}
+
+/// IContactInterface ///
+
+void APhysicsObject::ResolveContact(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector Normal, FVector Velocity, FVector OtherVelocity)
 {
 	if (OtherActor != nullptr && OtherActor != this)
 	{
@@ -115,7 +113,7 @@ void APhysicsObject::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPr
 		IPhysicsInterface* object = Cast<IPhysicsInterface>(OtherActor);
 		if (object != nullptr)
 		{
-			MovementComponent->Impact(object, Hit.Normal);
+			MovementComponent->Impact(object, Normal, Velocity, OtherVelocity);
 		}
 	}
 }
@@ -149,7 +147,7 @@ void APhysicsObject::AddRelativeImpulse(FVector Force)
 
 void APhysicsObject::AddStaticForce(FVector Force)
 {
-	MovementComponent->SetStaticForce(Force);
+	MovementComponent->SetStaticForce(PhysicsModifiers.GetForce() + Force);
 }
 
 void APhysicsObject::RemoveStaticForce(FVector Force)
@@ -159,63 +157,40 @@ void APhysicsObject::RemoveStaticForce(FVector Force)
 
 void APhysicsObject::ResetStaticForce()
 {
-	MovementComponent->ResetStaticForce();
-}
-
-void APhysicsObject::SetGravity(float NewGravity)
-{
-	MovementComponent->Gravity = NewGravity;
-}
-
-void APhysicsObject::ResetGravity()
-{
-	UCyberShooterGameInstance* instance = Cast<UCyberShooterGameInstance>(GetWorld()->GetGameInstance());
-	if (instance != nullptr)
+	// Fall back to the forces applied by zones
+	if (PhysicsModifiers.GetForce().IsZero())
 	{
-		MovementComponent->Gravity = instance->GetGravity();
+		MovementComponent->ResetStaticForce();
 	}
-}
-
-void APhysicsObject::SetAirFriction(float NewFriction)
-{
-	MovementComponent->AirFriction = NewFriction;
-}
-
-void APhysicsObject::ResetAirFriction()
-{
-	UCyberShooterGameInstance* instance = Cast<UCyberShooterGameInstance>(GetWorld()->GetGameInstance());
-	if (instance != nullptr)
+	else
 	{
-		MovementComponent->AirFriction = instance->GetAirFriction();
+		MovementComponent->SetStaticForce(PhysicsModifiers.GetForce());
 	}
 }
 
-void APhysicsObject::SetFriction(float NewFriction)
-{
-	MovementComponent->Friction = NewFriction;
-}
-
-void APhysicsObject::ResetFriction()
+void APhysicsObject::AddPhysicsModifier(const FPhysicsModifier& Modifier)
 {
-	MovementComponent->Friction = 1.0f;
+	PhysicsModifiers.Add(Modifier);
+	ApplyPhysicsModifiers();
 }
 
-void APhysicsObject::SetMass(float Multiplier)
+void APhysicsObject::RemovePhysicsModifier(const UObject* Source)
 {
-	MovementComponent->Mass = Mass * Multiplier;
+	if (PhysicsModifiers.Remove(Source))
+	{
+		ApplyPhysicsModifiers();
+	}
 }
 
-void APhysicsObject::ResetMass()
+void APhysicsObject::ApplyPhysicsModifiers()
 {
-	MovementComponent->Mass = Mass;
-}
+	MovementComponent->Gravity = PhysicsModifiers.GetGravity();
+	MovementComponent->Friction = PhysicsModifiers.GetFriction();
+	MovementComponent->Mass = Mass * PhysicsModifiers.GetMass();
+	MovementComponent->AirFriction = PhysicsModifiers.GetAirFriction();
+	MovementComponent->SetTickSpeed(PhysicsModifiers.GetTickRate());
 
-void APhysicsObject::SetTickRate(float NewRate)
-{
-	if (NewRate > 0.0f)
-	{
-		MovementComponent->SetTickSpeed(NewRate);
-	}
+	ResetStaticForce();
 }
 
 float APhysicsObject::GetMass() const
@@ -295,12 +270,17 @@ void APhysicsObject::Disable()
 
 void APhysicsObject::StartRespawn()
 {
-	RespawnTimer = RespawnDuration;
+	SetRespawnTimer(RespawnDuration);
 }
 
 void APhysicsObject::CancelRespawn()
 {
-	RespawnTimer = 0.0f;
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers != nullptr)
+	{
+		timers->ClearTimer(TimerHandle_RespawnTimer);
+		timers->ClearTimer(TimerHandle_BlinkTimer);
+	}
 	SetActorHiddenInGame(false);
 	SetActorEnableCollision(true);
 	Respawned = false;
@@ -311,13 +291,59 @@ void APhysicsObject::CancelRespawn()
 void APhysicsObject::Respawn()
 {
 	SetActorEnableCollision(false);
-	RespawnTimer = RespawnCooldown;
+	SetRespawnTimer(RespawnCooldown);
 	Respawned = true;
 
 	MovementComponent->Teleport(RespawnPoint);
 	SetOrientation_Internal(InitialForward, InitialUp);
 }
 
+void APhysicsObject::SetRespawnTimer(float Duration)
+{
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers != nullptr)
+	{
+		timers->SetTimer(TimerHandle_RespawnTimer, this, &APhysicsObject::RespawnTimeout, Duration);
+
+		// Blink until the respawn finishes
+		if (BlinkRate <= 0 || Duration <= 0.0f)
+		{
+			timers->ClearTimer(TimerHandle_BlinkTimer);
+		}
+		else if (!timers->IsTimerActive(TimerHandle_BlinkTimer))
+		{
+			timers->SetTimer(TimerHandle_BlinkTimer, this, &APhysicsObject::Blink, 2.0f / BlinkRate, true);
+		}
+	}
+}
+
+void APhysicsObject::RespawnTimeout()
+{
+	if (Respawned)
+	{
+		// Check for collisions inside the object to ensure it doesn't respawn inside another object
+		FHitResult hit;
+		if (GetWorld()->SweepSingleByChannel(hit, GetActorLocation(), GetActorLocation(), GetActorQuat(), GetStaticMeshComponent()->GetCollisionObjectType(), GetStaticMeshComponent()->GetCollisionShape()))
+		{
+			SetRespawnTimer(RespawnCooldown);
+		}
+		else
+		{
+			CancelRespawn();
+		}
+	}
+	else
+	{
+		Respawn();
+	}
+}
+
+void APhysicsObject::Blink()
+{
+	SetActorHiddenInGame(!IsHidden());
+	INC_DWORD_STAT(STAT_BlinkVisibilityChanges);
+}
+
 bool APhysicsObject::SetOrientation_Internal(FVector NewForward, FVector NewUp)
 {
 	if (!NewForward.IsNearlyZero() && !NewUp.IsNearlyZero())
@@ -343,6 +369,8 @@ AMimicObject::AMimicObject()
 {
 	AggroLevel = 0;
 	CanChangeOrientation = false;
+
+	PrimaryActorTick.bCanEverTick = true;
 }
 
 void AMimicObject::BeginPlay()
@@ -350,7 +378,7 @@ void AMimicObject::BeginPlay()
 	Super::BeginPlay();
 
 	// Get a reference the the player
-	Player = Cast<ACyberShooterPlayer>(UGameplayStatics::GetPlayerPawn(GetWorld(), 0));
+	Player = UActorRegistrySubsystem::FindPlayer(this);
 }
 
 void AMimicObject::Tick(float DeltaSeconds)
@@ -5,6 +5,8 @@
 #include "PhysicsInterface.h"
 #include "OrientationInterface.h"
 #include "AggroInterface.h"
+#include "ContactInterface.h"
+#include "TimingWheelSubsystem.h"
 
 #include "CoreMinimal.h"
 #include "PhysicalStaticMesh.h"
@@ -12,7 +14,7 @@
 
 // A static mesh object with physics enabled
 UCLASS()
-class CYBERSHOOTER_API APhysicsObject : public APhysicalStaticMesh, public IPhysicsInterface, public IOrientationInterface, public IAggroInterface
+class CYBERSHOOTER_API APhysicsObject : public APhysicalStaticMesh, public IPhysicsInterface, public IOrientationInterface, public IAggroInterface, public IContactInterface
 {
 	GENERATED_BODY()
 	
@@ -20,13 +22,17 @@ public:
 	APhysicsObject();
 
 	virtual void BeginPlay() override;
-	virtual void Tick(float DeltaSeconds) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual FVector GetVelocity() const override;
 
 	// Apply physics impulses on hitting obstacles
 	UFUNCTION()
 		virtual void OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit);
 
+	/// IContactInterface ///
+
+	virtual void ResolveContact(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector Normal, FVector Velocity, FVector OtherVelocity) override;
+
 	/// IPhysicsInterface ///
 	
 	FVector GetVelocity() override;
@@ -37,15 +43,8 @@ public:
 	void AddStaticForce(FVector Force) override;
 	void RemoveStaticForce(FVector Force) override;
 	void ResetStaticForce() override;
-	void SetGravity(float NewGravity) override;
-	void ResetGravity() override;
-	void SetAirFriction(float NewFriction) override;
-	void ResetAirFriction() override;
-	void SetFriction(float NewFriction) override;
-	void ResetFriction() override;
-	void SetMass(float Multiplier) override;
-	void ResetMass() override;
-	void SetTickRate(float NewRate) override;
+	void AddPhysicsModifier(const FPhysicsModifier& Modifier) override;
+	void RemovePhysicsModifier(const UObject* Source) override;
 	float GetMass() const override;
 	float GetWeight() const override;
 
@@ -84,12 +83,23 @@ public:
 		void Disable();
 
 protected:
+	// Copy the effective values of the physics modifier stack to the movement component
+	void ApplyPhysicsModifiers();
+	// The changes applied by the physics zones the object is in
+	FPhysicsModifierStack PhysicsModifiers;
+
 	// Start the respawn timer for the object
 	void StartRespawn();
 	// Cancel the respawn timer
 	void CancelRespawn();
 	// Respawn the object
 	void Respawn();
+	// Restart the respawn timer and start blinking
+	void SetRespawnTimer(float Duration);
+	// Called when the respawn timer runs out
+	void RespawnTimeout();
+	// Toggle visibility while respawning
+	void Blink();
 	// Internal implementation for orientation change
 	bool SetOrientation_Internal(FVector NewForward, FVector NewUp);
 
@@ -134,7 +144,9 @@ protected:
 		class UPhysicsMovementComponent* MovementComponent;
 
 	// The timer used to track respawns
-	float RespawnTimer;
+	FWheelTimerHandle TimerHandle_RespawnTimer;
+	// The timer that makes the object blink while respawning
+	FWheelTimerHandle TimerHandle_BlinkTimer;
 };
 
 // A physics object that adjusts its gravity direction to match the player
@@ -2,8 +2,12 @@
 
 #include "PhysicsZone.h"
 #include "CyberShooterProjectile.h"
+#include "ForceFieldSubsystem.h"
 #include "PhysicsInterface.h"
 
+#include "Components/BoxComponent.h"
+#include "Engine/World.h"
+
 APhysicsZone::APhysicsZone()
 {
 	PrimaryActorTick.bCanEverTick = false;
@@ -23,102 +27,99 @@ APhysicsZone::APhysicsZone()
 	Mass = 1.0f;
 	Force = FVector(0.0f);
 	TickSpeed = 1.0f;
+
+	ForceBox = nullptr;
 }
 
-void APhysicsZone::BeginOverlap(AActor* OverlappedActor, AActor* OtherActor)
+void APhysicsZone::PostInitializeComponents()
 {
-	// Set object attributes
-	IPhysicsInterface* object = Cast<IPhysicsInterface>(OtherActor);
-	if (object != nullptr)
+	Super::PostInitializeComponents();
+
+	// Box zones push bodies through the force field subsystem, which sums overlapping fields every frame
+	if (!Force.IsNearlyZero())
 	{
-		if (AffectGravity)
-		{
-			object->SetGravity(Gravity);
-		}
-		if (AffectFriction)
-		{
-			object->SetFriction(Friction);
-			object->SetAirFriction(AirFriction);
-		}
-		if (Mass != 1.0f)
-		{
-			object->SetMass(Mass);
-		}
-		if (!Force.IsNearlyZero())
+		ForceBox = FindComponentByClass<UBoxComponent>();
+	}
+
+	// Build the modifier once instead of checking each setting on every overlap
+	Modifier.Source = this;
+	Modifier.AffectGravity = AffectGravity;
+	Modifier.Gravity = Gravity;
+	Modifier.AffectFriction = AffectFriction;
+	Modifier.Friction = Friction;
+	Modifier.AirFriction = AirFriction;
+	Modifier.Mass = Mass;
+	Modifier.Force = (Force.IsNearlyZero() || ForceBox != nullptr) ? FVector(0.0f) : Force;
+	Modifier.TickRate = TickSpeed;
+}
+
+void APhysicsZone::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (ForceBox != nullptr)
+	{
+		UForceFieldSubsystem* fields = GetWorld()->GetSubsystem<UForceFieldSubsystem>();
+		if (fields != nullptr)
 		{
-			object->AddStaticForce(Force);
+			FForceField field;
+			field.Owner = this;
+			field.Type = EForceFieldType::Directional;
+			field.Center = ForceBox->GetComponentLocation();
+			field.Rotation = ForceBox->GetComponentQuat();
+			field.Extent = ForceBox->GetScaledBoxExtent();
+			field.Force = Force;
+			fields->SetField(field);
 		}
-		if (TickSpeed != 1.0f)
+	}
+}
+
+void APhysicsZone::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (ForceBox != nullptr)
+	{
+		UForceFieldSubsystem* fields = GetWorld()->GetSubsystem<UForceFieldSubsystem>();
+		if (fields != nullptr)
 		{
-			object->SetTickRate(TickSpeed);
+			fields->RemoveField(this);
 		}
 	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void APhysicsZone::BeginOverlap(AActor* OverlappedActor, AActor* OtherActor)
+{
+	// Push the zone's settings onto the object's modifier stack
+	IPhysicsInterface* object = Cast<IPhysicsInterface>(OtherActor);
+	if (object != nullptr)
+	{
+		object->AddPhysicsModifier(Modifier);
+	}
 	else
 	{
 		ACyberShooterProjectile* projectile = Cast<ACyberShooterProjectile>(OtherActor);
 		if (projectile != nullptr)
 		{
-			if (AffectFriction)
-			{
-				projectile->SetAirFriction(AirFriction);
-			}
-			if (!Force.IsNearlyZero())
-			{
-				projectile->SetStaticForce(Force);
-			}
-			if (TickSpeed != 1.0f)
-			{
-				projectile->SetTickSpeed(TickSpeed);
-			}
+			projectile->AddPhysicsModifier(Modifier);
 		}
 	}
 }
 
 void APhysicsZone::EndOverlap(AActor* OverlappedActor, AActor* OtherActor)
 {
-	// Reset object attributes
+	// Remove only this zone's settings, other zones the object is in stay applied
 	IPhysicsInterface* object = Cast<IPhysicsInterface>(OtherActor);
 	if (object != nullptr)
 	{
-		if (AffectGravity)
-		{
-			object->ResetGravity();
-		}
-		if (AffectFriction)
-		{
-			object->ResetFriction();
-			object->ResetAirFriction();
-		}
-		if (Mass != 1.0f)
-		{
-			object->ResetMass();
-		}
-		if (!Force.IsNearlyZero())
-		{
-			object->ResetStaticForce();
-		}
-		if (TickSpeed != 1.0f)
-		{
-			object->SetTickRate(1.0f);
-		}
+		object->RemovePhysicsModifier(this);
 	}
 	else
 	{
 		ACyberShooterProjectile* projectile = Cast<ACyberShooterProjectile>(OtherActor);
 		if (projectile != nullptr)
 		{
-			if (AffectFriction)
-			{
-				projectile->ResetAirFriction();
-			}
-			if (!Force.IsNearlyZero())
-			{
-				projectile->ResetStaticForce();
-			}
-			if (TickSpeed != 1.0f)
-			{
-				projectile->ResetTickSpeed();
-			}
+			projectile->RemovePhysicsModifier(this);
 		}
 	}
 }
\ No newline at end of file
@@ -2,10 +2,14 @@
 
 #pragma once
 
+#include "PhysicsModifierStack.h"
+
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "PhysicsZone.generated.h"
 
+class UBoxComponent;
+
 // An actor that changes the physics of all actor inside it
 UCLASS(BlueprintType, Blueprintable)
 class CYBERSHOOTER_API APhysicsZone : public AActor
@@ -15,6 +19,10 @@ class CYBERSHOOTER_API APhysicsZone : public AActor
 public:	
 	APhysicsZone();
 
+	virtual void PostInitializeComponents() override;
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	// Called when a pawn enters the physics zone to set the pawn's physics state
 	UFUNCTION()
 		void BeginOverlap(AActor* OverlappedActor, AActor* OtherActor);
@@ -48,8 +56,14 @@ protected:
 	// Static forces applied to pawns in the zone, will be ignored if set to zero
 	UPROPERTY(Category = "ZoneSettings|Force", EditAnywhere)
 		FVector Force;
+	// The box the force is applied in, if set the force is registered as a field instead of being added on overlap
+	UPROPERTY(VisibleInstanceOnly)
+		UBoxComponent* ForceBox;
 
 	// The tick speed of pawns inside the zone, will be ignored if set to 1
 	UPROPERTY(Category = "ZoneSettings|Time", EditAnywhere)
 		float TickSpeed;
+
+	// The zone settings in the form applied to physics bodies
+	FPhysicsModifier Modifier;
 };
\ No newline at end of file
@@ -47,9 +47,10 @@ void APowerUp::BeginOverlap(AActor* OverlappedActor, AActor* OtherActor)
 		// Collect the powerup and start the respawn timer
 		Collect(player);
 		TriggerCollectEvent();
-		if (RespawnDuration > 0.0f)
+		UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+		if (RespawnDuration > 0.0f && timers != nullptr)
 		{
-			GetWorld()->GetTimerManager().SetTimer(TimerHandle_RespawnTimer, this, &APowerUp::Respawn, RespawnDuration);
+			timers->SetTimer(TimerHandle_RespawnTimer, this, &APowerUp::Respawn, RespawnDuration);
 		}
 
 		Disable();
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "TimingWheelSubsystem.h"
+
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "PowerUp.generated.h"
@@ -72,5 +74,5 @@ protected:
 		USoundBase* CollectSound;
 
 	// The timer for managing respawns
-	FTimerHandle TimerHandle_RespawnTimer;
+	FWheelTimerHandle TimerHandle_RespawnTimer;
 };
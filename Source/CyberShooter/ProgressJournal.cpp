@@ -0,0 +1,418 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#include "ProgressJournal.h"
+#include "CyberShooterSave.h"
+#include "Weapon.h"
+#include "Ability.h"
+#include "CyberShooter.h"
+
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+static FAutoConsoleCommand JournalBenchmarkCommand(
+	TEXT("cs.JournalBenchmark"),
+	TEXT("Measure the bytes written to disk per collectible with the progress journal and with a full save rewrite. Takes an optional collectible count and level count, defaulting to 100 and 50."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 num_events = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 100;
+		const int32 num_levels = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 50;
+
+		// A save partway through the game, with every level visited
+		UCyberShooterSave* save = NewObject<UCyberShooterSave>();
+		for (int32 i = 0; i < num_levels; ++i)
+		{
+			FLevelProgress& progress = save->GetLevel(FName(*FString::Printf(TEXT("Level%02d"), i)));
+			FLevelProgress::SetFlag(progress.LockState, 31);
+			FLevelProgress::SetFlag(progress.KeyCollected, 31);
+			FLevelProgress::SetFlag(progress.HealthUpgradeCollected, 3);
+		}
+		const FName level(TEXT("Level00"));
+		const TArray<UWeapon*> weapons;
+		const TArray<UAbility*> abilities;
+
+		// Each collectible writes a flag record and the player's progress, as collecting an upgrade does
+		TSharedRef<FProgressJournal, ESPMode::ThreadSafe> journal = MakeShared<FProgressJournal, ESPMode::ThreadSafe>();
+		journal->SetSlot(TEXT("JournalBenchmark"));
+		journal->Clear();
+		journal->Wait();
+
+		double start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < num_events; ++i)
+		{
+			journal->RecordFlag(EJournalRecord::Key, level, i % 32);
+			journal->RecordPlayer(5, 3, i, weapons, abilities);
+		}
+		journal->Wait();
+		const double journal_time = FPlatformTime::Seconds() - start;
+
+		const int64 journal_bytes = journal->GetJournalSize();
+		journal->Clear();
+		journal->Wait();
+
+		// Without the journal every collectible has to rewrite the whole save to reach the disk
+		int64 rewrite_bytes = 0;
+		TArray<uint8> data;
+		start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < num_events; ++i)
+		{
+			FLevelProgress::SetFlag(save->GetLevel(level).KeyCollected, i % 32);
+			save->TotalKeys = i;
+			save->WriteArchive(data);
+			rewrite_bytes += data.Num();
+		}
+		const double rewrite_time = FPlatformTime::Seconds() - start;
+
+		save->MarkPendingKill();
+
+		UE_LOG(LogCyberShooter, Log, TEXT("%d collectibles, %d levels"), num_events, num_levels);
+		UE_LOG(LogCyberShooter, Log, TEXT("Journal: %lld bytes, %.1f bytes per collectible, %.4f ms"), journal_bytes, (double)journal_bytes / num_events, journal_time * 1000.0);
+		UE_LOG(LogCyberShooter, Log, TEXT("Full rewrite: %lld bytes, %.1f bytes per collectible, %.4f ms serializing"), rewrite_bytes, (double)rewrite_bytes / num_events, rewrite_time * 1000.0);
+		UE_LOG(LogCyberShooter, Log, TEXT("Write amplification of a full rewrite over the journal: %.1fx"), journal_bytes > 0 ? (double)rewrite_bytes / journal_bytes : 0.0);
+	}));
+
+FProgressJournal::FProgressJournal()
+{
+	Generation = 1;
+	PendingCompact = INDEX_NONE;
+	Writing = false;
+	WriteSerial = 0;
+}
+
+void FProgressJournal::SetSlot(const FString& SaveName)
+{
+	BasePath = FPaths::ProjectSavedDir() / TEXT("SaveGames") / SaveName;
+}
+
+/// Records ///
+
+void FProgressJournal::RecordFlag(EJournalRecord Type, FName Level, int32 Slot)
+{
+	FMemoryWriter writer(Buffer, false, true);
+
+	// Each record starts with its size so a record torn by a crash can be detected
+	const int64 start = writer.Tell();
+	int32 size = 0;
+	uint8 type = (uint8)Type;
+	writer << size;
+	writer << type;
+	writer << Level;
+	writer << Slot;
+
+	size = (int32)(writer.Tell() - start) - sizeof(size);
+	writer.Seek(start);
+	writer << size;
+
+	Flush();
+}
+
+void FProgressJournal::RecordPlayer(int32 MaxHealth, int32 MaxMomentum, int32 TotalKeys, const TArray<UWeapon*>& Weapons, const TArray<UAbility*>& Abilities)
+{
+	TArray<FString> weapon_paths;
+	for (UWeapon* weapon : Weapons)
+	{
+		if (weapon != nullptr)
+		{
+			weapon_paths.Add(FSoftObjectPath(weapon).ToString());
+		}
+	}
+	TArray<FString> ability_paths;
+	for (UAbility* ability : Abilities)
+	{
+		if (ability != nullptr)
+		{
+			ability_paths.Add(FSoftObjectPath(ability).ToString());
+		}
+	}
+
+	FMemoryWriter writer(Buffer, false, true);
+
+	const int64 start = writer.Tell();
+	int32 size = 0;
+	uint8 type = (uint8)EJournalRecord::Player;
+	writer << size;
+	writer << type;
+	writer << MaxHealth;
+	writer << MaxMomentum;
+	writer << TotalKeys;
+	writer << weapon_paths;
+	writer << ability_paths;
+
+	size = (int32)(writer.Tell() - start) - sizeof(size);
+	writer.Seek(start);
+	writer << size;
+
+	Flush();
+}
+
+/// Checkpoints ///
+
+int32 FProgressJournal::BeginSnapshot()
+{
+	// Hand the current file's records to the writer, new records go to the next file
+	if (Buffer.Num() > 0)
+	{
+		PendingAppends.Emplace(Generation, MoveTemp(Buffer));
+		Buffer.Reset();
+	}
+
+	return Generation++;
+}
+
+void FProgressJournal::Compact(int32 SnapshotGeneration)
+{
+	PendingCompact = FMath::Max(PendingCompact, SnapshotGeneration);
+	Flush();
+}
+
+void FProgressJournal::Clear()
+{
+	Buffer.Reset();
+	PendingAppends.Reset();
+	PendingCompact = MAX_int32;
+	Generation = 1;
+	Flush();
+}
+
+void FProgressJournal::Replay(UCyberShooterSave* Save)
+{
+	// Make sure every record has reached the disk
+	Wait();
+
+	int32 last_generation = Save->JournalGeneration;
+	for (int32 generation : FindJournals(BasePath))
+	{
+		last_generation = FMath::Max(last_generation, generation);
+		if (generation <= Save->JournalGeneration)
+			continue;
+
+		TArray<uint8> data;
+		if (!FFileHelper::LoadFileToArray(data, *GetJournalPath(BasePath, generation)))
+			continue;
+
+		int32 records = 0;
+		FMemoryReader reader(data);
+		while (reader.Tell() + (int64)sizeof(int32) <= data.Num())
+		{
+			int32 size = 0;
+			reader << size;
+
+			// Stop at a record that was only partly written
+			const int64 end = reader.Tell() + size;
+			if (size <= 0 || end > data.Num())
+				break;
+
+			uint8 type = 0;
+			reader << type;
+			if ((EJournalRecord)type == EJournalRecord::Player)
+			{
+				TArray<FString> weapon_paths;
+				TArray<FString> ability_paths;
+				reader << Save->MaxHealth;
+				reader << Save->MaxMomentum;
+				reader << Save->TotalKeys;
+				reader << weapon_paths;
+				reader << ability_paths;
+
+				Save->Weapons.Reset();
+				for (const FString& path : weapon_paths)
+				{
+					UWeapon* weapon = Cast<UWeapon>(FSoftObjectPath(path).TryLoad());
+					if (weapon != nullptr)
+					{
+						Save->Weapons.Add(weapon);
+					}
+				}
+				Save->Abilities.Reset();
+				for (const FString& path : ability_paths)
+				{
+					UAbility* ability = Cast<UAbility>(FSoftObjectPath(path).TryLoad());
+					if (ability != nullptr)
+					{
+						Save->Abilities.Add(ability);
+					}
+				}
+			}
+			else
+			{
+				FName level;
+				int32 slot = 0;
+				reader << level;
+				reader << slot;
+
+				FLevelProgress& progress = Save->GetLevel(level);
+				switch ((EJournalRecord)type)
+				{
+				case EJournalRecord::HealthUpgrade:
+					FLevelProgress::SetFlag(progress.HealthUpgradeCollected, slot);
+					break;
+				case EJournalRecord::MomentumUpgrade:
+					FLevelProgress::SetFlag(progress.MomentumUpgradeCollected, slot);
+					break;
+				case EJournalRecord::Key:
+					FLevelProgress::SetFlag(progress.KeyCollected, slot);
+					break;
+				case EJournalRecord::Weapon:
+					progress.WeaponCollected = true;
+					break;
+				case EJournalRecord::Ability:
+					progress.AbilityCollected = true;
+					break;
+				case EJournalRecord::Lock:
+					FLevelProgress::SetFlag(progress.LockState, slot);
+					break;
+				default:
+					break;
+				}
+			}
+
+			if (reader.IsError())
+				break;
+
+			reader.Seek(end);
+			records++;
+		}
+
+		UE_LOG(LogCyberShooter, Log, TEXT("Replayed %d progress records from journal %d"), records, generation);
+	}
+
+	// Continue past every existing file, they are deleted once the next save covers them
+	Generation = last_generation + 1;
+}
+
+void FProgressJournal::Flush()
+{
+#if PLATFORM_DESKTOP
+	if (Writing || BasePath.IsEmpty())
+		return;
+
+	if (Buffer.Num() > 0)
+	{
+		PendingAppends.Emplace(Generation, MoveTemp(Buffer));
+		Buffer.Reset();
+	}
+	if (PendingAppends.Num() == 0 && PendingCompact == INDEX_NONE)
+		return;
+
+	Writing = true;
+	const uint32 serial = ++WriteSerial;
+
+	TWeakPtr<FProgressJournal, ESPMode::ThreadSafe> journal = AsShared();
+	WriteTask = Async(EAsyncExecution::ThreadPool, [journal, serial, Base = BasePath, Appends = MoveTemp(PendingAppends), Compact = PendingCompact]()
+	{
+		for (const TPair<int32, TArray<uint8>>& append : Appends)
+		{
+			TUniquePtr<FArchive> file(IFileManager::Get().CreateFileWriter(*GetJournalPath(Base, append.Key), FILEWRITE_Append));
+			if (file.IsValid())
+			{
+				file->Serialize(const_cast<uint8*>(append.Value.GetData()), append.Value.Num());
+				file->Close();
+			}
+		}
+
+		// Delete covered files after appending, so records appended to them in the same batch don't leave the files behind
+		if (Compact != INDEX_NONE)
+		{
+			for (int32 generation : FindJournals(Base))
+			{
+				if (generation <= Compact)
+				{
+					IFileManager::Get().Delete(*GetJournalPath(Base, generation), false, false, true);
+				}
+			}
+		}
+
+		// Report back on the game thread
+		AsyncTask(ENamedThreads::GameThread, [journal, serial]()
+		{
+			TSharedPtr<FProgressJournal, ESPMode::ThreadSafe> pinned = journal.Pin();
+			if (pinned.IsValid())
+			{
+				pinned->FinishWrite(serial);
+			}
+		});
+	});
+
+	PendingAppends.Reset();
+	PendingCompact = INDEX_NONE;
+#else
+	// Platform save systems can't append, so progress is only kept by checkpoint saves
+	Buffer.Reset();
+	PendingAppends.Reset();
+	PendingCompact = INDEX_NONE;
+#endif
+}
+
+void FProgressJournal::Wait()
+{
+	if (WriteTask.IsValid())
+	{
+		WriteTask.Wait();
+		WriteTask = TFuture<void>();
+	}
+	Writing = false;
+
+	// Write anything left synchronously
+	Flush();
+	if (WriteTask.IsValid())
+	{
+		WriteTask.Wait();
+		WriteTask = TFuture<void>();
+	}
+	Writing = false;
+}
+
+void FProgressJournal::FinishWrite(uint32 Serial)
+{
+	// Wait may have finished this write and started a newer one that is still running
+	if (!Writing || Serial != WriteSerial)
+		return;
+
+	Writing = false;
+	WriteTask = TFuture<void>();
+
+	// Write records added while the last write was running
+	Flush();
+}
+
+int64 FProgressJournal::GetJournalSize() const
+{
+	int64 size = 0;
+	for (int32 generation : FindJournals(BasePath))
+	{
+		size += FMath::Max(IFileManager::Get().FileSize(*GetJournalPath(BasePath, generation)), (int64)0);
+	}
+
+	return size;
+}
+
+FString FProgressJournal::GetJournalPath(const FString& BasePath, int32 Generation)
+{
+	return FString::Printf(TEXT("%s.%d.journal"), *BasePath, Generation);
+}
+
+TArray<int32> FProgressJournal::FindJournals(const FString& BasePath)
+{
+	TArray<FString> files;
+	IFileManager::Get().FindFiles(files, *(BasePath + TEXT(".*.journal")), true, false);
+
+	// File names are the slot name, the generation and the extension
+	const FString prefix = FPaths::GetCleanFilename(BasePath) + TEXT(".");
+	TArray<int32> generations;
+	for (const FString& file : files)
+	{
+		const FString generation = FPaths::GetBaseFilename(file).RightChop(prefix.Len());
+		if (file.StartsWith(prefix) && generation.IsNumeric())
+		{
+			generations.Add(FCString::Atoi(*generation));
+		}
+	}
+	generations.Sort();
+
+	return generations;
+}
@@ -0,0 +1,92 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Async/Future.h"
+
+class UCyberShooterSave;
+class UWeapon;
+class UAbility;
+
+// The types of record stored in the progress journal
+enum class EJournalRecord : uint8
+{
+	HealthUpgrade,
+	MomentumUpgrade,
+	Key,
+	Weapon,
+	Ability,
+	Lock,
+	// The player's upgrades, keys and equipment after collecting something
+	Player
+};
+
+// An append-only log of progress made since the last checkpoint save, so collectibles and locks survive a crash
+// Records are written to numbered journal files in the background, each checkpoint save starts a new file and
+// deletes the files it covers once the save is on disk, and loading a save replays any newer files
+class CYBERSHOOTER_API FProgressJournal : public TSharedFromThis<FProgressJournal, ESPMode::ThreadSafe>
+{
+public:
+	FProgressJournal();
+
+	// Set the save slot the journal belongs to
+	void SetSlot(const FString& SaveName);
+
+	/// Records ///
+
+	// Record a collectible or lock flag being set in a level
+	void RecordFlag(EJournalRecord Type, FName Level, int32 Slot);
+	// Record the player's current progress
+	void RecordPlayer(int32 MaxHealth, int32 MaxMomentum, int32 TotalKeys, const TArray<UWeapon*>& Weapons, const TArray<UAbility*>& Abilities);
+
+	/// Checkpoints ///
+
+	// Start a new journal file for a save snapshot, returns the generation of the records the snapshot contains
+	int32 BeginSnapshot();
+	// Delete the journal files covered by a save that has finished writing
+	void Compact(int32 SnapshotGeneration);
+	// Delete every journal file for the slot, used when a new game is started
+	void Clear();
+	// Apply records newer than a loaded save to it
+	void Replay(UCyberShooterSave* Save);
+
+	// Start writing buffered records in the background
+	void Flush();
+	// Block until the background write has finished
+	void Wait();
+
+	// Get the total size of the slot's journal files on disk
+	int64 GetJournalSize() const;
+
+private:
+	// Called on the game thread when a background write finishes, writes that Wait already finished are ignored
+	void FinishWrite(uint32 Serial);
+
+	// Get the path of a journal file
+	static FString GetJournalPath(const FString& BasePath, int32 Generation);
+	// Find the generations of the slot's journal files, in ascending order
+	static TArray<int32> FindJournals(const FString& BasePath);
+
+	// The path of the slot's journal files without the generation and extension
+	FString BasePath;
+	// The generation new records are written to
+	int32 Generation;
+
+	// Records for the current generation that haven't been submitted to a write
+	TArray<uint8> Buffer;
+	// Records waiting for the running write to finish, with their generation
+	TArray<TPair<int32, TArray<uint8>>> PendingAppends;
+	// Journal files with this generation or lower are deleted by the next write
+	int32 PendingCompact;
+
+	// Set to true while a background write is running
+	bool Writing;
+	// Counts the background writes started, so a write's completion can be matched to it
+	uint32 WriteSerial;
+	// The background write
+	TFuture<void> WriteTask;
+
+	// The journal test inspects the journal files directly
+	friend class FProgressJournalReplayTest;
+};
@@ -0,0 +1,79 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#include "ProgressJournal.h"
+#include "CyberShooterSave.h"
+#include "CyberShooter.h"
+
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FProgressJournalReplayTest, "CyberShooter.ProgressJournal.Replay", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FProgressJournalReplayTest::RunTest(const FString& Parameters)
+{
+	const FString slot = TEXT("AutomationJournal");
+	const FName level(TEXT("AutomationLevel"));
+
+	TSharedRef<FProgressJournal, ESPMode::ThreadSafe> writer = MakeShared<FProgressJournal, ESPMode::ThreadSafe>();
+	writer->SetSlot(slot);
+	writer->Clear();
+	writer->Wait();
+
+	// The first generation is covered by the save but was never compacted, as if the game stopped before the save finished
+	writer->RecordFlag(EJournalRecord::Key, level, 3);
+	const int32 covered = writer->BeginSnapshot();
+
+	// The second generation holds progress made after the save, the last record is torn by a crash
+	writer->RecordFlag(EJournalRecord::Key, level, 5);
+	writer->RecordFlag(EJournalRecord::Lock, level, 2);
+	writer->RecordFlag(EJournalRecord::Key, level, 9);
+	writer->Wait();
+
+	const FString torn_path = FProgressJournal::GetJournalPath(writer->BasePath, covered + 1);
+	TArray<uint8> data;
+	if (!TestTrue(TEXT("Journal was written"), FFileHelper::LoadFileToArray(data, *torn_path)))
+		return false;
+	data.SetNum(data.Num() - 3);
+	FFileHelper::SaveArrayToFile(data, *torn_path);
+
+	// Replay into a save from a new journal, as the game does after a restart
+	TSharedRef<FProgressJournal, ESPMode::ThreadSafe> journal = MakeShared<FProgressJournal, ESPMode::ThreadSafe>();
+	journal->SetSlot(slot);
+	UCyberShooterSave* save = NewObject<UCyberShooterSave>();
+	save->JournalGeneration = covered;
+	journal->Replay(save);
+
+	const FLevelProgress& progress = save->GetLevel(level);
+	TestFalse(TEXT("Records covered by the save are skipped"), FLevelProgress::GetFlag(progress.KeyCollected, 3));
+	TestTrue(TEXT("Key record is replayed"), FLevelProgress::GetFlag(progress.KeyCollected, 5));
+	TestTrue(TEXT("Lock record is replayed"), FLevelProgress::GetFlag(progress.LockState, 2));
+	TestFalse(TEXT("Torn record is ignored"), FLevelProgress::GetFlag(progress.KeyCollected, 9));
+	TestEqual(TEXT("New records go past the existing journals"), journal->Generation, covered + 2);
+
+	// Records appended to a generation in the same write that compacts it must not leave the file behind
+	journal->RecordFlag(EJournalRecord::Key, level, 1);
+	journal->RecordFlag(EJournalRecord::Key, level, 2);
+	const int32 snapshot = journal->BeginSnapshot();
+	journal->Compact(snapshot);
+	journal->Wait();
+	TestEqual(TEXT("Compacted journals are deleted"), FProgressJournal::FindJournals(journal->BasePath).Num(), 0);
+
+	// A write that Wait already finished reports back late, it must not end the write started after it
+	journal->RecordFlag(EJournalRecord::Key, level, 4);
+	const uint32 finished = journal->WriteSerial;
+	journal->Wait();
+	journal->RecordFlag(EJournalRecord::Key, level, 6);
+	journal->FinishWrite(finished);
+	TestTrue(TEXT("A late completion doesn't end the running write"), journal->Writing);
+	journal->Wait();
+
+	journal->Clear();
+	journal->Wait();
+	save->MarkPendingKill();
+
+	return true;
+}
+
+#endif
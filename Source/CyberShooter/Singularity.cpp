@@ -1,78 +1,47 @@
 // Copyright © 2020 Brian Faubion. All rights reserved.
 
 #include "Singularity.h"
-#include "CyberShooterProjectile.h"
-#include "PhysicsInterface.h"
+#include "ForceFieldSubsystem.h"
 
 #include "Components/SphereComponent.h"
-
-#include "Engine/Engine.h"
+#include "Engine/World.h"
 
 ASingularity::ASingularity()
 {
-	PrimaryActorTick.bCanEverTick = true;
-
-	OnActorBeginOverlap.AddDynamic(this, &ASingularity::BeginOverlap);
-	OnActorEndOverlap.AddDynamic(this, &ASingularity::EndOverlap);
+	PrimaryActorTick.bCanEverTick = false;
 
-	// Create the collision sphere
+	// Create the field sphere, the field is evaluated by the force field subsystem so the sphere doesn't need overlaps
 	CollisionComponent = CreateDefaultSubobject<USphereComponent>(TEXT("CollisionComponent"));
-	CollisionComponent->SetCollisionProfileName("OverlapAll");
+	CollisionComponent->SetCollisionProfileName("NoCollision");
 	CollisionComponent->SetSphereRadius(50.0f);
 	CollisionComponent->SetMobility(EComponentMobility::Static);
 	RootComponent = CollisionComponent;
 }
 
-void ASingularity::BeginOverlap(AActor* OverlappedActor, AActor* OtherActor)
+void ASingularity::BeginPlay()
 {
-	// Add objects to the list
-	IPhysicsInterface* object = Cast<IPhysicsInterface>(OtherActor);
-	if (object != nullptr)
-	{
-		Objects.Add(OtherActor);
-	}
-	else
-	{
-		ACyberShooterProjectile* projectile = Cast<ACyberShooterProjectile>(OtherActor);
-		if (projectile != nullptr)
-		{
-			Projectiles.Add(projectile);
-		}
-	}
-}
+	Super::BeginPlay();
 
-void ASingularity::EndOverlap(AActor* OverlappedActor, AActor* OtherActor)
-{
-	// Remove objects from the list
-	IPhysicsInterface* object = Cast<IPhysicsInterface>(OtherActor);
-	if (object != nullptr)
-	{
-		Objects.Remove(OtherActor);
-		object->ResetStaticForce();
-	}
-	else
+	UForceFieldSubsystem* fields = GetWorld()->GetSubsystem<UForceFieldSubsystem>();
+	if (fields != nullptr)
 	{
-		ACyberShooterProjectile* projectile = Cast<ACyberShooterProjectile>(OtherActor);
-		if (projectile != nullptr)
-		{
-			Projectiles.Remove(projectile);
-			projectile->ResetStaticForce();
-		}
+		FForceField field;
+		field.Owner = this;
+		field.Type = EForceFieldType::Radial;
+		field.Center = CollisionComponent->GetComponentLocation();
+		field.Radius = CollisionComponent->GetScaledSphereRadius();
+		field.Strength = Force;
+		fields->SetField(field);
 	}
 }
 
-void ASingularity::Tick(float DeltaTime)
+void ASingularity::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	for (int32 i = 0; i < Objects.Num(); ++i)
+	UForceFieldSubsystem* fields = GetWorld()->GetSubsystem<UForceFieldSubsystem>();
+	if (fields != nullptr)
 	{
-		// Apply force to objects
-		FVector direction = GetActorLocation() - Objects[i]->GetActorLocation();
-		Cast<IPhysicsInterface>(Objects[i])->AddStaticForce(direction.GetSafeNormal() * Force);
-	}
-	for (int32 i = 0; i < Projectiles.Num(); ++i)
-	{
-		// Apply force to projectiles
-		FVector direction = GetActorLocation() - Projectiles[i]->GetActorLocation();
-		Projectiles[i]->SetStaticForce(direction.GetSafeNormal() * Force);
+		fields->RemoveField(this);
 	}
+
+	Super::EndPlay(EndPlayReason);
 }
\ No newline at end of file
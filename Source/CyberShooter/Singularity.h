@@ -6,9 +6,6 @@
 #include "GameFramework/Actor.h"
 #include "Singularity.generated.h"
 
-class IPhysicsInterface;
-class ACyberShooterProjectile;
-
 // A gadget that pulls objects and projectiles within its bounds towards its center
 UCLASS()
 class CYBERSHOOTER_API ASingularity : public AActor
@@ -18,28 +15,16 @@ class CYBERSHOOTER_API ASingularity : public AActor
 public:	
 	ASingularity();
 
-	// Called when a pawn enters the singularity to apply force
-	UFUNCTION()
-		void BeginOverlap(AActor* OverlappedActor, AActor* OtherActor);
-	// Called when a pawn leaves the sinularity to remove static forces
-	UFUNCTION()
-		void EndOverlap(AActor* OverlappedActor, AActor* OtherActor);
-
-	virtual void Tick(float DeltaTime) override;
+	// Register the singularity's field with the force field subsystem
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 protected:
 	// The force that the singularity applies
 	UPROPERTY(Category = "Physics", EditAnywhere)
 		float Force;
 
-	// Objects inside the singularity
-	UPROPERTY(VisibleAnywhere)
-		TArray<AActor*> Objects;
-	// Projectiles inside the singularity
-	UPROPERTY(VisibleAnywhere)
-		TArray<ACyberShooterProjectile*> Projectiles;
-
-	// The collision capsule
+	// The sphere that sets the bounds of the field
 	UPROPERTY(Category = "Components", VisibleDefaultsOnly, BlueprintReadOnly)
 		class USphereComponent* CollisionComponent;
 };
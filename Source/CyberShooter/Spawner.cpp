@@ -4,7 +4,10 @@
 
 #include "CyberShooterEnemy.h"
 #include "AggroZone.h"
+#include "ActorRegistrySubsystem.h"
 
+#include "Components/SphereComponent.h"
+#include "Engine/CollisionProfile.h"
 #include "Engine/Engine.h"
 
 ASpawner::ASpawner()
@@ -12,35 +15,180 @@ ASpawner::ASpawner()
 	SpawnComponent = CreateDefaultSubobject<USceneComponent>(TEXT("SpawnComponent"));
 	SpawnComponent->SetupAttachment(RootComponent);
 
+	SpawnVolume = CreateDefaultSubobject<USphereComponent>(TEXT("SpawnVolume"));
+	SpawnVolume->SetCollisionProfileName(UCollisionProfile::CustomCollisionProfileName);
+	SpawnVolume->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	SpawnVolume->SetCollisionResponseToAllChannels(ECR_Ignore);
+	SpawnVolume->SetGenerateOverlapEvents(false);
+	SpawnVolume->SetSphereRadius(100.0f);
+	SpawnVolume->SetupAttachment(SpawnComponent);
+
+	SpawnSlots.Add(FVector(0.0f));
+	SpawnSlots.Add(FVector(100.0f, 0.0f, 0.0f));
+	SpawnSlots.Add(FVector(-100.0f, 0.0f, 0.0f));
+	SpawnSlots.Add(FVector(0.0f, 100.0f, 0.0f));
+	SpawnSlots.Add(FVector(0.0f, -100.0f, 0.0f));
+
+	CachedSlot = INDEX_NONE;
+	SlotCacheValid = false;
+
 	RequiredAggro = 1;
 	MaxMinions = 5;
 	SpawnTime = 5.0f;
 	KillMinions = false;
+	PoolMinions = true;
 
 	MinimumAggro = 0;
 }
 
+void ASpawner::PostInitializeComponents()
+{
+	Super::PostInitializeComponents();
+
+	// Add the actor to the world's registry
+	UActorRegistrySubsystem* registry = GetWorld()->GetSubsystem<UActorRegistrySubsystem>();
+	if (registry != nullptr)
+	{
+		registry->Register(this);
+	}
+}
+
+void ASpawner::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Pick up zones that baked their membership instead of registering at runtime
+	UActorRegistrySubsystem* registry = UActorRegistrySubsystem::Get(this);
+	if (registry != nullptr)
+	{
+		TArray<AAggroZone*> zones;
+		registry->FindBakedZones(this, zones);
+		for (int32 i = 0; i < zones.Num(); ++i)
+		{
+			ZoneIndex.Add(zones[i]);
+			if (!Ephemeral)
+			{
+				ParentZone.AddUnique(zones[i]);
+			}
+		}
+	}
+
+	if (EnemyType == nullptr)
+	{
+		return;
+	}
+
+	// Size the spawn volume to cover every slot
+	const UPrimitiveComponent* template_root = Cast<UPrimitiveComponent>(EnemyType->GetDefaultObject<AEnemyMinion>()->GetRootComponent());
+	float radius = template_root != nullptr ? template_root->GetCollisionShape().GetExtent().Size() : 0.0f;
+	float slot_distance = 0.0f;
+	for (int32 i = 0; i < SpawnSlots.Num(); ++i)
+	{
+		slot_distance = FMath::Max(slot_distance, SpawnSlots[i].Size());
+	}
+	SpawnVolume->SetSphereRadius(slot_distance + radius);
+
+	// Create the minion pool up front so spawning doesn't create pawns and controllers during combat
+	if (PoolMinions)
+	{
+		for (int32 i = 0; i < MaxMinions; ++i)
+		{
+			AEnemyMinion* enemy = CreateMinion(SpawnComponent->GetComponentLocation(), SpawnComponent->GetComponentRotation());
+			if (enemy != nullptr)
+			{
+				enemy->SetPooled(true);
+				enemy->DisablePawn();
+				Pool.Push(enemy);
+			}
+		}
+	}
+}
+
+void ASpawner::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// Minions still in play outlive the spawner and are destroyed normally when killed, unless the spawner's room is being unloaded
+	for (int32 i = 0; i < Minions.Num(); ++i)
+	{
+		if (Minions[i] != nullptr)
+		{
+			Minions[i]->SetPooled(false);
+			if (EndPlayReason == EEndPlayReason::RemovedFromWorld)
+			{
+				Minions[i]->Destroy();
+			}
+		}
+	}
+
+	// Remove unused pooled minions
+	for (int32 i = 0; i < Pool.Num(); ++i)
+	{
+		if (Pool[i] != nullptr)
+		{
+			Pool[i]->Destroy();
+		}
+	}
+	Pool.Empty();
+
+	UActorRegistrySubsystem* registry = GetWorld()->GetSubsystem<UActorRegistrySubsystem>();
+	if (registry != nullptr)
+	{
+		registry->Unregister(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void ASpawner::SpawnChild()
 {
-	if (!Disabled && Minions.Num() < MaxMinions)
+	if (!Disabled && EnemyType != nullptr && Minions.Num() < MaxMinions)
 	{
-		// Try to spawn an enemy
-		FActorSpawnParameters spawn_params;
-		spawn_params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::DontSpawnIfColliding;
-		AEnemyMinion* enemy = GetWorld()->SpawnActor<AEnemyMinion>(EnemyType.Get(), SpawnComponent->GetComponentLocation(), SpawnComponent->GetComponentRotation(), spawn_params);
+		// Discard pooled minions that were destroyed by something else
+		while (Pool.Num() > 0 && (Pool.Last() == nullptr || Pool.Last()->IsPendingKill()))
+		{
+			Pool.Pop(false);
+		}
+
+		AEnemyMinion* enemy = nullptr;
+		const int32 slot = FindFreeSlot();
+		if (slot != INDEX_NONE)
+		{
+			const FVector location = SpawnComponent->GetComponentTransform().TransformPosition(SpawnSlots[slot]);
+			const FRotator rotation = SpawnComponent->GetComponentRotation();
 
-		// Claim ownership of the newly spawned enemy and set its aggro to match this spawner
+			if (Pool.Num() > 0)
+			{
+				// Reuse a pooled minion
+				enemy = Pool.Pop(false);
+				enemy->ActivateMinion(location, rotation);
+			}
+			else
+			{
+				// Spawn a new enemy
+				enemy = CreateMinion(location, rotation);
+				if (enemy != nullptr && PoolMinions)
+				{
+					enemy->SetPooled(true);
+				}
+			}
+		}
+
+		// Set the minion's aggro to match this spawner
 		if (enemy != nullptr)
 		{
-			enemy->SpawnDefaultController();
-			enemy->ClaimPawn(this);
 			enemy->SetAggro(RequiredAggro, MinimumAggro);
 			Minions.Push(enemy);
+
+			// The new minion's collision is off while it respawns, so the slot has to be checked again next time
+			SlotCacheValid = false;
 		}
 	}
 
 	// Restart the spawn timer
-	GetWorld()->GetTimerManager().SetTimer(TimerHandle_SpawnTimer, this, &ASpawner::SpawnChild, SpawnTime);
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers != nullptr)
+	{
+		timers->SetTimer(TimerHandle_SpawnTimer, this, &ASpawner::SpawnChild, SpawnTime);
+	}
 }
 
 void ASpawner::KillChildren()
@@ -55,6 +203,103 @@ void ASpawner::KillChildren()
 void ASpawner::NotifyDeath(AEnemyMinion* Child)
 {
 	Minions.Remove(Child);
+
+	// Return pooled minions to the pool
+	if (Child->IsPooled())
+	{
+		Pool.AddUnique(Child);
+	}
+}
+
+bool ASpawner::IsInZone(const AAggroZone* Zone) const
+{
+	return ZoneIndex.Contains(Zone);
+}
+
+AEnemyMinion* ASpawner::CreateMinion(FVector Location, FRotator Rotation)
+{
+	// Slots are checked before spawning, so the spawn doesn't need its own encroachment test
+	FActorSpawnParameters spawn_params;
+	spawn_params.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	AEnemyMinion* enemy = GetWorld()->SpawnActor<AEnemyMinion>(EnemyType.Get(), Location, Rotation, spawn_params);
+
+	// Claim ownership of the newly spawned enemy
+	if (enemy != nullptr)
+	{
+		enemy->SpawnDefaultController();
+		enemy->ClaimPawn(this);
+	}
+
+	return enemy;
+}
+
+int32 ASpawner::FindFreeSlot()
+{
+	const UPrimitiveComponent* template_root = Cast<UPrimitiveComponent>(EnemyType->GetDefaultObject<AEnemyMinion>()->GetRootComponent());
+	if (template_root == nullptr)
+	{
+		return INDEX_NONE;
+	}
+
+	// Gather everything that could block a minion inside the spawn volume with a single query
+	const FCollisionShape shape = template_root->GetCollisionShape();
+	const FQuat rotation = SpawnComponent->GetComponentQuat();
+	FCollisionQueryParams query_params(SCENE_QUERY_STAT(SpawnerSlots), false, this);
+	FCollisionResponseParams response_params(template_root->GetCollisionResponseToChannels());
+
+	TArray<FOverlapResult> overlaps;
+	GetWorld()->OverlapMultiByChannel(overlaps, SpawnVolume->GetComponentLocation(), rotation, template_root->GetCollisionObjectType(), FCollisionShape::MakeSphere(SpawnVolume->GetScaledSphereRadius()), query_params, response_params);
+
+	TArray<UPrimitiveComponent*, TInlineAllocator<8>> blockers;
+	for (const FOverlapResult& overlap : overlaps)
+	{
+		UPrimitiveComponent* component = overlap.GetComponent();
+		if (overlap.bBlockingHit && component != nullptr)
+		{
+			blockers.Add(component);
+		}
+	}
+
+	// Reuse the last result if nothing has entered, left or moved inside the volume since
+	bool cache_valid = SlotCacheValid && blockers.Num() == CachedBlockers.Num();
+	for (int32 i = 0; i < blockers.Num() && cache_valid; ++i)
+	{
+		cache_valid = CachedBlockers[i].Get() == blockers[i] && CachedBlockerLocations[i].Equals(blockers[i]->GetComponentLocation());
+	}
+	if (cache_valid)
+	{
+		return CachedSlot;
+	}
+
+	CachedBlockers.Reset();
+	CachedBlockerLocations.Reset();
+	for (UPrimitiveComponent* component : blockers)
+	{
+		CachedBlockers.Add(component);
+		CachedBlockerLocations.Add(component->GetComponentLocation());
+	}
+	CachedSlot = INDEX_NONE;
+	SlotCacheValid = true;
+
+	// Pick the first slot that none of the blocking components overlap
+	for (int32 i = 0; i < SpawnSlots.Num(); ++i)
+	{
+		const FVector location = SpawnComponent->GetComponentTransform().TransformPosition(SpawnSlots[i]);
+
+		bool blocked = false;
+		for (int32 j = 0; j < blockers.Num() && !blocked; ++j)
+		{
+			blocked = blockers[j]->OverlapComponent(location, rotation, shape);
+		}
+
+		if (!blocked)
+		{
+			CachedSlot = i;
+			break;
+		}
+	}
+
+	return CachedSlot;
 }
 
 /// ICombatInterface ///
@@ -66,14 +311,18 @@ void ASpawner::Kill()
 	{
 		KillChildren();
 	}
-	GetWorld()->GetTimerManager().ClearTimer(TimerHandle_SpawnTimer);
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers != nullptr)
+	{
+		timers->ClearTimer(TimerHandle_SpawnTimer);
+	}
 
 	// Notify parent zones that the spawner has despawned
 	if (!Ephemeral)
 	{
 		for (int32 i = 0; i < ParentZone.Num(); ++i)
 		{
-			ParentZone[i]->NotifyDespawn();
+			ParentZone[i]->NotifyDespawn(this);
 		}
 	}
 
@@ -89,9 +338,10 @@ void ASpawner::Aggro()
 	if (AggroLevel >= RequiredAggro)
 	{
 		// Start the spawn timer
-		if (!GetWorld()->GetTimerManager().TimerExists(TimerHandle_SpawnTimer))
+		UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+		if (timers != nullptr && !timers->IsTimerActive(TimerHandle_SpawnTimer))
 		{
-			GetWorld()->GetTimerManager().SetTimer(TimerHandle_SpawnTimer, this, &ASpawner::SpawnChild, SpawnTime);
+			timers->SetTimer(TimerHandle_SpawnTimer, this, &ASpawner::SpawnChild, SpawnTime);
 		}
 	}
 
@@ -109,9 +359,10 @@ void ASpawner::EndAggro()
 	if (AggroLevel <= MinimumAggro)
 	{
 		// Cancel the timer
-		if (GetWorld()->GetTimerManager().GetTimerRemaining(TimerHandle_SpawnTimer) > 0.0f)
+		UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+		if (timers != nullptr)
 		{
-			GetWorld()->GetTimerManager().ClearTimer(TimerHandle_SpawnTimer);
+			timers->ClearTimer(TimerHandle_SpawnTimer);
 		}
 	}
 
@@ -129,11 +380,19 @@ void ASpawner::AggroReset()
 	KillChildren();
 }
 
+bool ASpawner::BakeZone(AAggroZone* Zone)
+{
+	return !Ephemeral;
+}
+
 void ASpawner::RegisterZone(AAggroZone* Zone)
 {
+	ZoneIndex.Add(Zone);
+
+	// Rooms register their actors each time they are shown, so a zone may register the same actor again
 	if (!Ephemeral)
 	{
-		ParentZone.Add(Zone);
+		ParentZone.AddUnique(Zone);
 		Zone->NotifyRegister();
 	}
 }
\ No newline at end of file
@@ -17,6 +17,10 @@ class CYBERSHOOTER_API ASpawner : public ADestructible
 public:
 	ASpawner();
 
+	virtual void BeginPlay() override;
+	virtual void PostInitializeComponents() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	// Spawn a new child
 	void SpawnChild();
 	// Kill all the spawner's children
@@ -24,6 +28,8 @@ public:
 
 	// Notify this spawner that one of its children has died
 	void NotifyDeath(AEnemyMinion* Child);
+	// Returns true if the spawner is controlled by an aggro zone
+	bool IsInZone(const class AAggroZone* Zone) const;
 
 	/// ICombatInterface ///
 
@@ -35,6 +41,7 @@ public:
 	virtual void EndAggro() override;
 	virtual void AggroReset() override;
 	virtual void RegisterZone(class AAggroZone* Zone) override;
+	virtual bool BakeZone(class AAggroZone* Zone) override;
 
 	/// Accessors ///
 	
@@ -56,6 +63,15 @@ protected:
 	// If set to true, all the minions of this spawner will die when the spawner dies
 	UPROPERTY(Category = "Spawner", EditAnywhere)
 		bool KillMinions;
+	// If set to true, MaxMinions minions and their controllers are created at level load and reused instead of spawned and destroyed
+	UPROPERTY(Category = "Spawner", EditAnywhere)
+		bool PoolMinions;
+	// Pooled minions that are waiting to be spawned
+	UPROPERTY(Category = "Spawner", VisibleAnywhere)
+		TArray<AEnemyMinion*> Pool;
+	// Candidate spawn locations relative to the spawn component, checked in order
+	UPROPERTY(Category = "Spawner", EditAnywhere)
+		TArray<FVector> SpawnSlots;
 
 	// The aggro required to deactive AI
 	UPROPERTY(Category = "Aggro", EditAnywhere)
@@ -63,11 +79,30 @@ protected:
 	// The zones that this spawner belongs to
 	UPROPERTY(Category = "Aggro", EditAnywhere)
 		TArray<AAggroZone*> ParentZone;
+	// Every zone that registered this spawner, including zones that don't track it for clearing
+	TSet<const AAggroZone*> ZoneIndex;
 
 	// The component that determines the spawn location of enemies
 	UPROPERTY(Category = "Components", VisibleDefaultsOnly, BlueprintReadOnly)
 		USceneComponent* SpawnComponent;
+	// The volume around the spawn slots, queried for anything that could block a slot
+	// It doesn't generate overlap events, so nothing entering it triggers the spawner's actor overlap events
+	UPROPERTY(Category = "Components", VisibleDefaultsOnly, BlueprintReadOnly)
+		class USphereComponent* SpawnVolume;
+
+	// Create a new minion and its controller
+	AEnemyMinion* CreateMinion(FVector Location, FRotator Rotation);
+	// Find the first spawn slot that isn't blocked, returns INDEX_NONE if every slot is blocked
+	int32 FindFreeSlot();
+
+	// The result of the last slot check
+	int32 CachedSlot;
+	// Set to false when the spawner changes the contents of the spawn volume itself
+	bool SlotCacheValid;
+	// The blocking components inside the spawn volume at the last slot check and where they were, the cached slot is reused while they match
+	TArray<TWeakObjectPtr<UPrimitiveComponent>> CachedBlockers;
+	TArray<FVector> CachedBlockerLocations;
 
 	// The timer handle for enemy spawning
-	FTimerHandle TimerHandle_SpawnTimer;
+	FWheelTimerHandle TimerHandle_SpawnTimer;
 };
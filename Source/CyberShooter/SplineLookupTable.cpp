@@ -0,0 +1,74 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#include "SplineLookupTable.h"
+
+#include "Components/SplineComponent.h"
+
+FSplineLookupTable::FSplineLookupTable()
+{
+	Version = 0;
+	Duration = 0.0f;
+	TimeToSample = 0.0f;
+}
+
+void FSplineLookupTable::Build(const USplineComponent* Spline, int32 SamplesPerSegment)
+{
+	Empty();
+
+	if (Spline == nullptr || Spline->GetNumberOfSplinePoints() == 0)
+		return;
+
+	Version = Spline->SplineCurves.Version;
+	Duration = Spline->Duration;
+
+	const int32 num_points = Spline->GetNumberOfSplinePoints();
+	PointLocations.Reserve(num_points);
+	for (int32 i = 0; i < num_points; ++i)
+	{
+		PointLocations.Add(Spline->GetLocationAtSplinePoint(i, ESplineCoordinateSpace::Local));
+	}
+
+	// Sample at constant velocity to match GetLocationAtTime with bUseConstantVelocity set
+	const int32 num_intervals = FMath::Max(Spline->GetNumberOfSplineSegments() * FMath::Max(SamplesPerSegment, 1), 1);
+	Locations.Reserve(num_intervals + 1);
+	for (int32 i = 0; i <= num_intervals; ++i)
+	{
+		Locations.Add(Spline->GetLocationAtTime(Duration * i / num_intervals, ESplineCoordinateSpace::Local, true));
+	}
+
+	TimeToSample = Duration > 0.0f ? num_intervals / Duration : 0.0f;
+}
+
+void FSplineLookupTable::Empty()
+{
+	Locations.Reset();
+	PointLocations.Reset();
+	Version = 0;
+	Duration = 0.0f;
+	TimeToSample = 0.0f;
+}
+
+bool FSplineLookupTable::IsValidFor(const USplineComponent* Spline) const
+{
+	// The spline bumps its version whenever its points change
+	return Locations.Num() > 0 && Spline->SplineCurves.Version == Version && Spline->Duration == Duration && Spline->GetNumberOfSplinePoints() == PointLocations.Num();
+}
+
+FVector FSplineLookupTable::GetLocationAtTime(float Time) const
+{
+	const int32 last = Locations.Num() - 1;
+	if (last <= 0)
+		return last == 0 ? Locations[0] : FVector::ZeroVector;
+
+	const float position = FMath::Clamp(Time * TimeToSample, 0.0f, (float)last);
+	const int32 index = FMath::Min((int32)position, last - 1);
+	return FMath::Lerp(Locations[index], Locations[index + 1], position - index);
+}
+
+FVector FSplineLookupTable::GetLocationAtSplinePoint(int32 Point) const
+{
+	if (PointLocations.Num() == 0)
+		return FVector::ZeroVector;
+
+	return PointLocations[FMath::Clamp(Point, 0, PointLocations.Num() - 1)];
+}
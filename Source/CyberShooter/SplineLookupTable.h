@@ -0,0 +1,42 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class USplineComponent;
+
+// A spline baked into evenly spaced samples over its duration, so following the spline costs a single lerp instead of a curve evaluation
+// Samples are stored in the spline's local space and only rebuilt when the spline's points or duration change
+class CYBERSHOOTER_API FSplineLookupTable
+{
+public:
+	FSplineLookupTable();
+
+	// Sample the spline at constant velocity, using SamplesPerSegment samples between each pair of spline points
+	void Build(const USplineComponent* Spline, int32 SamplesPerSegment);
+	// Remove every sample
+	void Empty();
+
+	// Returns true if the table was built from the spline and the spline hasn't been edited since
+	bool IsValidFor(const USplineComponent* Spline) const;
+
+	// Get the local location at a time along the spline, clamped to the spline's duration
+	FVector GetLocationAtTime(float Time) const;
+	// Get the local location of a spline point, clamped to the spline's points
+	FVector GetLocationAtSplinePoint(int32 Point) const;
+
+	FORCEINLINE int32 Num() const { return Locations.Num(); }
+
+private:
+	// The location at each sample time
+	TArray<FVector> Locations;
+	// The location of each spline point
+	TArray<FVector> PointLocations;
+
+	// The spline settings the table was built from
+	uint32 Version;
+	float Duration;
+	// Converts a time to a position in Locations
+	float TimeToSample;
+};
@@ -0,0 +1,66 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#include "SplineLookupTable.h"
+#include "CyberShooter.h"
+
+#include "Components/SplineComponent.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FSplineLookupAccuracyTest, "CyberShooter.SplineLookup.Accuracy", EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FSplineLookupAccuracyTest::RunTest(const FString& Parameters)
+{
+	// The largest distance the lookup may stray from the engine's evaluation, in world units
+	const float tolerance = 1.0f;
+	const int32 samples_per_segment = 32;
+	const int32 num_samples = 10000;
+
+	// A winding path with tight turns and changes in height, like a moving platform's route
+	USplineComponent* spline = NewObject<USplineComponent>(GetTransientPackage());
+	spline->ClearSplinePoints(false);
+	spline->AddSplinePoint(FVector(0.0f, 0.0f, 0.0f), ESplineCoordinateSpace::Local, false);
+	spline->AddSplinePoint(FVector(1000.0f, 0.0f, 200.0f), ESplineCoordinateSpace::Local, false);
+	spline->AddSplinePoint(FVector(1200.0f, 800.0f, 0.0f), ESplineCoordinateSpace::Local, false);
+	spline->AddSplinePoint(FVector(400.0f, 1000.0f, -300.0f), ESplineCoordinateSpace::Local, false);
+	spline->AddSplinePoint(FVector(300.0f, 2500.0f, 0.0f), ESplineCoordinateSpace::Local, false);
+	spline->Duration = 10.0f;
+	spline->UpdateSpline();
+
+	FSplineLookupTable table;
+	table.Build(spline, samples_per_segment);
+	TestTrue(TEXT("Table is valid for the spline it was built from"), table.IsValidFor(spline));
+	TestEqual(TEXT("Table has a sample per interval"), table.Num(), (spline->GetNumberOfSplineSegments() * samples_per_segment) + 1);
+
+	// Compare the lookup against constant velocity evaluation at random times
+	FRandomStream stream(num_samples);
+	float max_error = 0.0f;
+	for (int32 i = 0; i < num_samples; ++i)
+	{
+		const float time = stream.FRandRange(0.0f, spline->Duration);
+		const FVector expected = spline->GetLocationAtTime(time, ESplineCoordinateSpace::Local, true);
+		max_error = FMath::Max(max_error, FVector::Dist(expected, table.GetLocationAtTime(time)));
+	}
+	TestTrue(FString::Printf(TEXT("Largest lookup error %.3f is within %.3f"), max_error, tolerance), max_error <= tolerance);
+
+	// The endpoints and spline points are exact
+	TestTrue(TEXT("Start matches the spline"), table.GetLocationAtTime(0.0f).Equals(spline->GetLocationAtTime(0.0f, ESplineCoordinateSpace::Local, true), KINDA_SMALL_NUMBER));
+	TestTrue(TEXT("End matches the spline"), table.GetLocationAtTime(spline->Duration).Equals(spline->GetLocationAtTime(spline->Duration, ESplineCoordinateSpace::Local, true), KINDA_SMALL_NUMBER));
+	for (int32 i = 0; i < spline->GetNumberOfSplinePoints(); ++i)
+	{
+		TestTrue(TEXT("Spline point matches the spline"), table.GetLocationAtSplinePoint(i).Equals(spline->GetLocationAtSplinePoint(i, ESplineCoordinateSpace::Local)));
+	}
+
+	// Editing the spline invalidates the table
+	spline->SetLocationAtSplinePoint(2, FVector(1500.0f, 900.0f, 100.0f), ESplineCoordinateSpace::Local, true);
+	TestFalse(TEXT("Table is invalid after the spline is edited"), table.IsValidFor(spline));
+
+	spline->MarkPendingKill();
+
+	return true;
+}
+
+#endif
@@ -1,8 +1,73 @@
 // Copyright © 2020 Brian Faubion. All rights reserved.
 
 #include "SplineMovementComponent.h"
+#include "CyberShooter.h"
 
 #include "Components/SplineComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "UObject/UObjectIterator.h"
+
+static TAutoConsoleVariable<int32> CVarSplineLookup(
+	TEXT("cs.SplineLookup"),
+	1,
+	TEXT("Follow splines using baked lookup tables instead of evaluating the spline every tick.\n")
+	TEXT("0: Evaluate the spline\n")
+	TEXT("1: Sample the lookup table"),
+	ECVF_Default);
+
+static FAutoConsoleCommandWithWorld SplineLookupBenchmarkCommand(
+	TEXT("cs.SplineLookupBenchmark"),
+	TEXT("Compare the baked lookup table of every spline movement component against the engine's spline evaluation, logging the largest error and the time per sample."),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+	{
+		const int32 num_samples = 10000;
+		FRandomStream stream(num_samples);
+
+		for (TObjectIterator<USplineMovementComponent> it; it; ++it)
+		{
+			const USplineComponent* spline = it->Spline;
+			if (it->GetWorld() != World || spline == nullptr || spline->Duration <= 0.0f)
+				continue;
+
+			FSplineLookupTable table;
+			table.Build(spline, it->GetSamplesPerSegment());
+
+			TArray<float> times;
+			times.SetNumUninitialized(num_samples);
+			for (int32 i = 0; i < num_samples; ++i)
+			{
+				times[i] = stream.FRandRange(0.0f, spline->Duration);
+			}
+
+			// Time the engine evaluation and the lookup over the same times
+			const FTransform& transform = spline->GetComponentTransform();
+			double start = FPlatformTime::Seconds();
+			for (int32 i = 0; i < num_samples; ++i)
+			{
+				spline->GetWorldLocationAtTime(times[i], true);
+			}
+			const double engine_time = FPlatformTime::Seconds() - start;
+
+			start = FPlatformTime::Seconds();
+			for (int32 i = 0; i < num_samples; ++i)
+			{
+				transform.TransformPosition(table.GetLocationAtTime(times[i]));
+			}
+			const double lookup_time = FPlatformTime::Seconds() - start;
+
+			float max_error = 0.0f;
+			for (int32 i = 0; i < num_samples; ++i)
+			{
+				const FVector expected = spline->GetWorldLocationAtTime(times[i], true);
+				max_error = FMath::Max(max_error, FVector::Dist(expected, transform.TransformPosition(table.GetLocationAtTime(times[i]))));
+			}
+
+			UE_LOG(LogCyberShooter, Log, TEXT("%s: %d samples, max error %.3f, engine %.3f us, lookup %.3f us per sample"),
+				*it->GetOwner()->GetName(), table.Num(), max_error, engine_time * 1000000.0 / num_samples, lookup_time * 1000000.0 / num_samples);
+		}
+	}));
 
 USplineMovementComponent::USplineMovementComponent()
 {
@@ -17,6 +82,7 @@ USplineMovementComponent::USplineMovementComponent()
 	Delay = 1.0f;
 	OneWay = false;
 	Reverse = false;
+	SamplesPerSegment = 32;
 
 	Timer = 0.0f;
 	IsDelayed = true;
@@ -27,6 +93,12 @@ void USplineMovementComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
+	// Bake the spline before the first tick
+	if (Spline != nullptr)
+	{
+		Lookup.Build(Spline, SamplesPerSegment);
+	}
+
 	if (FullPath)
 	{
 		if (!OneWay)
@@ -64,6 +136,12 @@ void USplineMovementComponent::TickComponent(float DeltaTime, enum ELevelTick Ti
 	if (!CanMove || Spline == nullptr)
 		return;
 
+	// Rebake the spline if it has been edited
+	if (!Lookup.IsValidFor(Spline))
+	{
+		Lookup.Build(Spline, SamplesPerSegment);
+	}
+
 	// Manage the movement timer
 	if (Timer > 0.0f)
 	{
@@ -103,11 +181,11 @@ void USplineMovementComponent::TickComponent(float DeltaTime, enum ELevelTick Ti
 		{
 			if (Reverse)
 			{
-				delta = Spline->GetWorldLocationAtTime(Timer, true) - UpdatedComponent->GetComponentLocation();
+				delta = GetWorldLocationAtTime(Timer) - UpdatedComponent->GetComponentLocation();
 			}
 			else
 			{
-				delta = Spline->GetWorldLocationAtTime(Spline->Duration - Timer, true) - UpdatedComponent->GetComponentLocation();
+				delta = GetWorldLocationAtTime(Spline->Duration - Timer) - UpdatedComponent->GetComponentLocation();
 			}
 		}
 		else
@@ -116,11 +194,11 @@ void USplineMovementComponent::TickComponent(float DeltaTime, enum ELevelTick Ti
 			FVector distance;
 			if (Reverse)
 			{
-				distance = Spline->GetWorldLocationAtSplinePoint(CurrentPoint - 1) - Spline->GetWorldLocationAtSplinePoint(CurrentPoint);
+				distance = GetWorldLocationAtSplinePoint(CurrentPoint - 1) - GetWorldLocationAtSplinePoint(CurrentPoint);
 			}
 			else
 			{
-				distance = Spline->GetWorldLocationAtSplinePoint(CurrentPoint + 1) - Spline->GetWorldLocationAtSplinePoint(CurrentPoint);
+				distance = GetWorldLocationAtSplinePoint(CurrentPoint + 1) - GetWorldLocationAtSplinePoint(CurrentPoint);
 			}
 			distance = distance * DeltaTime / Spline->Duration;
 
@@ -134,22 +212,22 @@ void USplineMovementComponent::TickComponent(float DeltaTime, enum ELevelTick Ti
 		{
 			if (Reverse)
 			{
-				delta = Spline->GetWorldLocationAtSplinePoint(0) - UpdatedComponent->GetComponentLocation();
+				delta = GetWorldLocationAtSplinePoint(0) - UpdatedComponent->GetComponentLocation();
 			}
 			else
 			{
-				delta = Spline->GetWorldLocationAtSplinePoint(Spline->GetNumberOfSplinePoints() - 1) - UpdatedComponent->GetComponentLocation();
+				delta = GetWorldLocationAtSplinePoint(Spline->GetNumberOfSplinePoints() - 1) - UpdatedComponent->GetComponentLocation();
 			}
 		}
 		else
 		{
 			if (Reverse)
 			{
-				delta = Spline->GetWorldLocationAtSplinePoint(CurrentPoint - 1) - UpdatedComponent->GetComponentLocation();
+				delta = GetWorldLocationAtSplinePoint(CurrentPoint - 1) - UpdatedComponent->GetComponentLocation();
 			}
 			else
 			{
-				delta = Spline->GetWorldLocationAtSplinePoint(CurrentPoint + 1) - UpdatedComponent->GetComponentLocation();
+				delta = GetWorldLocationAtSplinePoint(CurrentPoint + 1) - UpdatedComponent->GetComponentLocation();
 			}
 		}
 	}
@@ -322,4 +400,20 @@ void USplineMovementComponent::StopMoving()
 {
 	Timer = Delay;
 	IsDelayed = true;
+}
+
+FVector USplineMovementComponent::GetWorldLocationAtTime(float Time) const
+{
+	if (CVarSplineLookup.GetValueOnGameThread() == 0)
+		return Spline->GetWorldLocationAtTime(Time, true);
+
+	return Spline->GetComponentTransform().TransformPosition(Lookup.GetLocationAtTime(Time));
+}
+
+FVector USplineMovementComponent::GetWorldLocationAtSplinePoint(int32 Point) const
+{
+	if (CVarSplineLookup.GetValueOnGameThread() == 0)
+		return Spline->GetWorldLocationAtSplinePoint(Point);
+
+	return Spline->GetComponentTransform().TransformPosition(Lookup.GetLocationAtSplinePoint(Point));
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "SplineLookupTable.h"
+
 #include "CoreMinimal.h"
 #include "GameFramework/MovementComponent.h"
 #include "SplineMovementComponent.generated.h"
@@ -27,6 +29,8 @@ public:
 	// Force the platform to move towards its end point
 	void MoveToEnd();
 
+	FORCEINLINE int32 GetSamplesPerSegment() const { return SamplesPerSegment; }
+
 	// Set to false when moving from the starting spline point to the end, and true to move from the end to the start
 	// If OneWay is enabled, this will dictate the direction the pawn moves at all times
 	// Otherwise the pawn will begin at the start or end of the spline when play begins based on this setting, then flip this setting when it reaches an endpoint
@@ -39,6 +43,11 @@ protected:
 	// Stop the object's movement
 	void StopMoving();
 
+	// Get the world location at a time along the spline at constant velocity
+	FVector GetWorldLocationAtTime(float Time) const;
+	// Get the world location of a spline point
+	FVector GetWorldLocationAtSplinePoint(int32 Point) const;
+
 public:
 	/// Properties ///
 
@@ -72,6 +81,12 @@ protected:
 	// Otherwise it will move back and forth between the two
 	UPROPERTY(Category = "Movement", EditAnywhere)
 		bool OneWay;
+	// The number of lookup samples baked between each pair of spline points, higher values follow tight curves more closely
+	UPROPERTY(Category = "Movement", EditAnywhere, AdvancedDisplay, meta = (ClampMin = "1"))
+		int32 SamplesPerSegment;
+
+	// The spline baked for cheap sampling, rebuilt when the spline is edited
+	FSplineLookupTable Lookup;
 
 	// The current spline point the actor is travelling from
 	int32 CurrentPoint;
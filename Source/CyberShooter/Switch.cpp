@@ -85,10 +85,11 @@ void ASwitch::TriggerSwitch()
 		}
 
 		// Start the switch cooldown
-		if (CooldownDuration > 0.0f)
+		UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+		if (CooldownDuration > 0.0f && timers != nullptr)
 		{
 			Cooldown = true;
-			GetWorld()->GetTimerManager().SetTimer(TimerHandle_SwitchCooldown, this, &ASwitch::CooldownTimeout, CooldownDuration);
+			timers->SetTimer(TimerHandle_SwitchCooldown, this, &ASwitch::CooldownTimeout, CooldownDuration);
 		}
 
 		// Call blueprint events
@@ -110,10 +111,11 @@ void ASwitch::ReleaseSwitch()
 		}
 
 		// Start the switch cooldown
-		if (CooldownDuration > 0.0f)
+		UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+		if (CooldownDuration > 0.0f && timers != nullptr)
 		{
 			Cooldown = true;
-			GetWorld()->GetTimerManager().SetTimer(TimerHandle_SwitchCooldown, this, &ASwitch::CooldownTimeout, CooldownDuration);
+			timers->SetTimer(TimerHandle_SwitchCooldown, this, &ASwitch::CooldownTimeout, CooldownDuration);
 		}
 
 		// Call blueprint events
@@ -139,9 +141,10 @@ void ASwitch::BeginOverlap(AActor* OverlappedActor, AActor* OtherActor)
 		if (TriggerDuration > 0.0f)
 		{
 			// Cancel the untrigger timer if one is set, otherwise trigger the switch
-			if (GetWorld()->GetTimerManager().GetTimerRemaining(TimerHandle_SwitchTimer) > 0.0f)
+			UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+			if (timers != nullptr && timers->IsTimerActive(TimerHandle_SwitchTimer))
 			{
-				GetWorld()->GetTimerManager().ClearTimer(TimerHandle_SwitchTimer);
+				timers->ClearTimer(TimerHandle_SwitchTimer);
 			}
 			else
 			{
@@ -165,10 +168,11 @@ void ASwitch::EndOverlap(AActor* OverlappedActor, AActor* OtherActor)
 	{
 		if (TotalWeight < RequiredWeight && Triggered)
 		{
-			if (TriggerDuration > 0.0f)
+			UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+			if (TriggerDuration > 0.0f && timers != nullptr)
 			{
 				// Stay triggered for a while
-				GetWorld()->GetTimerManager().SetTimer(TimerHandle_SwitchTimer, this, &ASwitch::TriggerTimeout, TriggerDuration);
+				timers->SetTimer(TimerHandle_SwitchTimer, this, &ASwitch::TriggerTimeout, TriggerDuration);
 			}
 			else
 			{
@@ -231,15 +235,16 @@ bool ASwitch_Damage::Damage(int32 Value, int32 DamageType, UForceFeedbackEffect*
 	// Make sure the damage is sufficient to trigger the switch
 	if (!(DamageImmunity & DamageType) && Value >= (int32)RequiredWeight)
 	{
+		UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
 		if (!Triggered)
 		{
 			// Trigger the switch
 			TriggerSwitch();
 
-			if (TriggerDuration > 0.0f)
+			if (TriggerDuration > 0.0f && timers != nullptr)
 			{
 				// Set the trigger timer
-				GetWorld()->GetTimerManager().SetTimer(TimerHandle_SwitchTimer, this, &ASwitch_Damage::TriggerTimeout, TriggerDuration);
+				timers->SetTimer(TimerHandle_SwitchTimer, this, &ASwitch_Damage::TriggerTimeout, TriggerDuration);
 			}
 		}
 		else if (!PermanentTrigger)
@@ -247,18 +252,18 @@ bool ASwitch_Damage::Damage(int32 Value, int32 DamageType, UForceFeedbackEffect*
 			// Untrigger the switch
 			ReleaseSwitch();
 
-			if (GetWorld()->GetTimerManager().GetTimerRemaining(TimerHandle_SwitchTimer) > 0.0f)
+			if (timers != nullptr)
 			{
 				// Cancel the untrigger timer
-				GetWorld()->GetTimerManager().ClearTimer(TimerHandle_SwitchTimer);
+				timers->ClearTimer(TimerHandle_SwitchTimer);
 			}
 		}
 		else
 		{
-			if (TriggerDuration > 0.0f)
+			if (TriggerDuration > 0.0f && timers != nullptr)
 			{
 				// Reset the timer
-				GetWorld()->GetTimerManager().SetTimer(TimerHandle_SwitchTimer, this, &ASwitch_Damage::TriggerTimeout, TriggerDuration);
+				timers->SetTimer(TimerHandle_SwitchTimer, this, &ASwitch_Damage::TriggerTimeout, TriggerDuration);
 			}
 		}
 
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CombatInterface.h"
+#include "TimingWheelSubsystem.h"
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
@@ -105,9 +106,9 @@ protected:
 		USoundBase* UntriggerSound;
 
 	// The timer handle for the trigger timer
-	FTimerHandle TimerHandle_SwitchTimer;
+	FWheelTimerHandle TimerHandle_SwitchTimer;
 	// The timer handle for cooldowns
-	FTimerHandle TimerHandle_SwitchCooldown;
+	FWheelTimerHandle TimerHandle_SwitchCooldown;
 };
 
 // A switch that can be triggered by overlapping a player
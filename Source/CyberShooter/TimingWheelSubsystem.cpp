@@ -0,0 +1,335 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#include "TimingWheelSubsystem.h"
+#include "CyberShooter.h"
+
+#include "Engine/World.h"
+
+DECLARE_CYCLE_STAT(TEXT("Timing Wheel"), STAT_TimingWheel, STATGROUP_CyberShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Wheel Timers"), STAT_WheelTimers, STATGROUP_CyberShooter);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Wheel Timers Fired"), STAT_WheelTimersFired, STATGROUP_CyberShooter);
+
+// The number of slots in the wheel, must be a power of two
+static const int32 WheelSlots = 256;
+// The number of wheel ticks per second of world time, timers fire on the first tick after they expire
+static const double WheelTickRate = 60.0;
+
+UTimingWheelSubsystem::UTimingWheelSubsystem()
+{
+	Time = 0.0;
+	CurrentTick = 0;
+	CallbackTime = 0.0;
+	Executing = false;
+	NumTimers = 0;
+}
+
+void UTimingWheelSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Slots.SetNum(WheelSlots);
+}
+
+void UTimingWheelSubsystem::Deinitialize()
+{
+	Timers.Empty();
+	FreeTimers.Empty();
+	Slots.Empty();
+	Expired.Empty();
+	NumTimers = 0;
+
+	Super::Deinitialize();
+}
+
+/// FTickableGameObject ///
+
+void UTimingWheelSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TimingWheel);
+
+	Time += DeltaTime;
+	const int64 target_tick = (int64)FMath::FloorToDouble(Time * WheelTickRate);
+
+	// Collect expired timers from each slot passed since the last update, visiting each slot at most once after a long frame
+	Expired.Reset();
+	for (int64 tick = FMath::Max(CurrentTick + 1, target_tick - WheelSlots + 1); tick <= target_tick; ++tick)
+	{
+		// Walk backwards so swapped entries have already been checked
+		TArray<int32>& slot = Slots[tick & (WheelSlots - 1)];
+		for (int32 i = slot.Num() - 1; i >= 0; --i)
+		{
+			const int32 index = slot[i];
+			if (Timers[index].ExpireTick <= target_tick)
+			{
+				Remove(index);
+				Timers[index].State = EWheelTimerState::Expired;
+				Expired.Add(TPair<int32, uint32>(index, Timers[index].Serial));
+			}
+		}
+	}
+	CurrentTick = target_tick;
+
+	SET_DWORD_STAT(STAT_WheelTimersFired, Expired.Num());
+
+	// Fire in deadline order
+	Expired.Sort([this](const TPair<int32, uint32>& A, const TPair<int32, uint32>& B) { return Timers[A.Key].ExpireTime < Timers[B.Key].ExpireTime; });
+
+	Executing = true;
+	for (int32 i = 0; i < Expired.Num(); ++i)
+	{
+		const int32 index = Expired[i].Key;
+
+		// Skip timers that were cleared or replaced by an earlier callback
+		FWheelTimer& timer = Timers[index];
+		if (timer.Serial != Expired[i].Value || timer.State != EWheelTimerState::Expired)
+		{
+			continue;
+		}
+
+		// Copy the delegate since the callback can add timers and reallocate the entries
+		const FTimerDelegate delegate = timer.Delegate;
+		CallbackTime = timer.ExpireTime;
+
+		if (timer.Interval > 0.0f && delegate.IsBound())
+		{
+			// Reschedule looping timers from their deadline
+			timer.Remaining = timer.Interval;
+			if (timer.TimeScale > 0.0f && !timer.Paused)
+			{
+				Insert(index, timer.ExpireTime + timer.Interval / timer.TimeScale);
+			}
+			else
+			{
+				timer.State = EWheelTimerState::Held;
+			}
+		}
+		else
+		{
+			Free(index);
+		}
+
+		delegate.ExecuteIfBound();
+	}
+	Executing = false;
+
+	SET_DWORD_STAT(STAT_WheelTimers, NumTimers);
+}
+
+ETickableTickType UTimingWheelSubsystem::GetTickableTickType() const
+{
+	// Don't tick the class default object
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Always;
+}
+
+bool UTimingWheelSubsystem::IsTickable() const
+{
+	return true;
+}
+
+TStatId UTimingWheelSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTimingWheelSubsystem, STATGROUP_Tickables);
+}
+
+UWorld* UTimingWheelSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+/// Timer Functions ///
+
+void UTimingWheelSubsystem::SetTimer(FWheelTimerHandle& Handle, const UObject* Owner, const FTimerDelegate& Delegate, float Duration, bool Loop, float TimeScale)
+{
+	ClearTimer(Handle);
+
+	if (Duration <= 0.0f || !Delegate.IsBound())
+	{
+		return;
+	}
+
+	const int32 index = FreeTimers.Num() > 0 ? FreeTimers.Pop(false) : Timers.AddDefaulted();
+	FWheelTimer& timer = Timers[index];
+	timer.Delegate = Delegate;
+	timer.Owner = Owner;
+	timer.Remaining = Duration;
+	timer.Interval = Loop ? Duration : 0.0f;
+	timer.TimeScale = FMath::Max(TimeScale, 0.0f);
+	timer.Paused = false;
+	timer.State = EWheelTimerState::Held;
+	NumTimers++;
+
+	Handle.Index = index;
+	Handle.Serial = timer.Serial;
+
+	if (timer.TimeScale > 0.0f)
+	{
+		Insert(index, (Executing ? CallbackTime : Time) + Duration / timer.TimeScale);
+	}
+}
+
+void UTimingWheelSubsystem::ClearTimer(FWheelTimerHandle& Handle)
+{
+	FWheelTimer* timer = FindTimer(Handle);
+	if (timer != nullptr)
+	{
+		if (timer->State == EWheelTimerState::Scheduled)
+		{
+			Remove(Handle.Index);
+		}
+		Free(Handle.Index);
+	}
+
+	Handle.Invalidate();
+}
+
+bool UTimingWheelSubsystem::IsTimerActive(const FWheelTimerHandle& Handle) const
+{
+	return FindTimer(Handle) != nullptr;
+}
+
+float UTimingWheelSubsystem::GetTimerRemaining(const FWheelTimerHandle& Handle) const
+{
+	const FWheelTimer* timer = FindTimer(Handle);
+	if (timer == nullptr)
+	{
+		return -1.0f;
+	}
+
+	switch (timer->State)
+	{
+	case EWheelTimerState::Scheduled:
+		return FMath::Max((float)(timer->ExpireTime - Time) * timer->TimeScale, 0.0f);
+	case EWheelTimerState::Held:
+		return timer->Remaining;
+	default:
+		return 0.0f;
+	}
+}
+
+void UTimingWheelSubsystem::SetTimerScale(const FWheelTimerHandle& Handle, float TimeScale)
+{
+	FWheelTimer* timer = FindTimer(Handle);
+	if (timer != nullptr)
+	{
+		// Convert the remaining time at the old rate, then reschedule at the new one
+		if (timer->State == EWheelTimerState::Scheduled)
+		{
+			Hold(Handle.Index);
+		}
+
+		timer->TimeScale = FMath::Max(TimeScale, 0.0f);
+
+		if (timer->State == EWheelTimerState::Held)
+		{
+			Release(Handle.Index);
+		}
+	}
+}
+
+void UTimingWheelSubsystem::PauseTimersForObject(const UObject* Object)
+{
+	for (int32 i = 0; i < Timers.Num(); ++i)
+	{
+		FWheelTimer& timer = Timers[i];
+		if (timer.Owner == Object && timer.State != EWheelTimerState::Free && !timer.Paused)
+		{
+			timer.Paused = true;
+			if (timer.State == EWheelTimerState::Scheduled)
+			{
+				Hold(i);
+			}
+		}
+	}
+}
+
+void UTimingWheelSubsystem::UnPauseTimersForObject(const UObject* Object)
+{
+	for (int32 i = 0; i < Timers.Num(); ++i)
+	{
+		FWheelTimer& timer = Timers[i];
+		if (timer.Owner == Object && timer.Paused)
+		{
+			timer.Paused = false;
+			if (timer.State == EWheelTimerState::Held)
+			{
+				Release(i);
+			}
+		}
+	}
+}
+
+/// Wheel Functions ///
+
+FWheelTimer* UTimingWheelSubsystem::FindTimer(const FWheelTimerHandle& Handle)
+{
+	if (Timers.IsValidIndex(Handle.Index))
+	{
+		FWheelTimer& timer = Timers[Handle.Index];
+		if (timer.Serial == Handle.Serial && timer.State != EWheelTimerState::Free)
+		{
+			return &timer;
+		}
+	}
+
+	return nullptr;
+}
+
+const FWheelTimer* UTimingWheelSubsystem::FindTimer(const FWheelTimerHandle& Handle) const
+{
+	return const_cast<UTimingWheelSubsystem*>(this)->FindTimer(Handle);
+}
+
+void UTimingWheelSubsystem::Insert(int32 Index, double ExpireTime)
+{
+	FWheelTimer& timer = Timers[Index];
+	timer.ExpireTime = ExpireTime;
+	timer.ExpireTick = FMath::Max(CurrentTick + 1, (int64)FMath::CeilToDouble(ExpireTime * WheelTickRate));
+	timer.Slot = timer.ExpireTick & (WheelSlots - 1);
+	timer.SlotPosition = Slots[timer.Slot].Add(Index);
+	timer.State = EWheelTimerState::Scheduled;
+}
+
+void UTimingWheelSubsystem::Remove(int32 Index)
+{
+	FWheelTimer& timer = Timers[Index];
+	TArray<int32>& slot = Slots[timer.Slot];
+
+	// Swap the last timer in the slot into the removed timer's place
+	slot.RemoveAtSwap(timer.SlotPosition, 1, false);
+	if (timer.SlotPosition < slot.Num())
+	{
+		Timers[slot[timer.SlotPosition]].SlotPosition = timer.SlotPosition;
+	}
+
+	timer.Slot = INDEX_NONE;
+	timer.SlotPosition = INDEX_NONE;
+}
+
+void UTimingWheelSubsystem::Hold(int32 Index)
+{
+	FWheelTimer& timer = Timers[Index];
+	timer.Remaining = FMath::Max((float)(timer.ExpireTime - Time) * timer.TimeScale, 0.0f);
+	Remove(Index);
+	timer.State = EWheelTimerState::Held;
+}
+
+void UTimingWheelSubsystem::Release(int32 Index)
+{
+	FWheelTimer& timer = Timers[Index];
+	if (timer.TimeScale > 0.0f && !timer.Paused)
+	{
+		Insert(Index, Time + timer.Remaining / timer.TimeScale);
+	}
+}
+
+void UTimingWheelSubsystem::Free(int32 Index)
+{
+	FWheelTimer& timer = Timers[Index];
+	timer.Delegate.Unbind();
+	timer.Owner = nullptr;
+	timer.State = EWheelTimerState::Free;
+	timer.Serial++;
+
+	FreeTimers.Add(Index);
+	NumTimers--;
+}
@@ -0,0 +1,157 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "TimingWheelSubsystem.generated.h"
+
+// A handle to a timer scheduled on the timing wheel
+struct FWheelTimerHandle
+{
+	FWheelTimerHandle() : Index(INDEX_NONE), Serial(0) {}
+
+	FORCEINLINE bool IsValid() const { return Index != INDEX_NONE; }
+	FORCEINLINE void Invalidate() { Index = INDEX_NONE; Serial = 0; }
+
+private:
+	friend class UTimingWheelSubsystem;
+
+	int32 Index;
+	uint32 Serial;
+};
+
+// The states a timer entry can be in
+enum class EWheelTimerState : uint8
+{
+	// The entry is unused
+	Free,
+	// The timer is waiting in a wheel slot
+	Scheduled,
+	// The timer is paused or has a time scale of zero and is out of the wheel
+	Held,
+	// The timer has expired this frame and is waiting for its callback
+	Expired
+};
+
+// A timer stored by the timing wheel
+struct FWheelTimer
+{
+	FWheelTimer() : Owner(nullptr), ExpireTime(0.0), ExpireTick(0), Remaining(0.0f), Interval(0.0f), TimeScale(1.0f), Slot(INDEX_NONE), SlotPosition(INDEX_NONE), Serial(0), State(EWheelTimerState::Free), Paused(false) {}
+
+	// The function called when the timer expires
+	FTimerDelegate Delegate;
+	// The object that set the timer
+	const UObject* Owner;
+
+	// The wheel time the timer expires at while it is scheduled
+	double ExpireTime;
+	// The wheel tick the timer expires on
+	int64 ExpireTick;
+	// The local time left on the timer while it is held
+	float Remaining;
+	// The local time between calls for looping timers, zero for timers that fire once
+	float Interval;
+	// The rate local time passes at relative to world time
+	float TimeScale;
+
+	// The slot holding the timer and the timer's position in it
+	int32 Slot;
+	int32 SlotPosition;
+	// Changed every time the entry is reused so old handles stop matching
+	uint32 Serial;
+
+	EWheelTimerState State;
+	// Set when the timer's owner has been paused
+	bool Paused;
+};
+
+// Runs gameplay countdowns on a hashed timing wheel so actors don't need to tick just to decrement a timer
+// Wheel time advances by the world's dilated delta time, and each timer carries a time scale for per-actor tick speeds
+UCLASS()
+class CYBERSHOOTER_API UTimingWheelSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UTimingWheelSubsystem();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/// FTickableGameObject ///
+
+	virtual void Tick(float DeltaTime) override;
+	virtual ETickableTickType GetTickableTickType() const override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	/// Timer Functions ///
+
+	// Call a function on an object after Duration seconds of local time, replacing the timer the handle refers to
+	template<class UserClass>
+	void SetTimer(FWheelTimerHandle& Handle, UserClass* Object, typename FTimerDelegate::TUObjectMethodDelegate<UserClass>::FMethodPtr Method, float Duration, bool Loop = false, float TimeScale = 1.0f)
+	{
+		SetTimer(Handle, Object, FTimerDelegate::CreateUObject(Object, Method), Duration, Loop, TimeScale);
+	}
+	// Call a delegate after Duration seconds of local time, a duration of zero or less clears the timer
+	void SetTimer(FWheelTimerHandle& Handle, const UObject* Owner, const FTimerDelegate& Delegate, float Duration, bool Loop, float TimeScale);
+	// Remove a timer and invalidate its handle
+	void ClearTimer(FWheelTimerHandle& Handle);
+
+	// Returns true if the handle refers to a timer that hasn't finished
+	bool IsTimerActive(const FWheelTimerHandle& Handle) const;
+	// Get the local time left on a timer, or -1 if the timer isn't active
+	float GetTimerRemaining(const FWheelTimerHandle& Handle) const;
+
+	// Change the rate a timer counts down at, a scale of zero holds the timer until the scale is raised
+	void SetTimerScale(const FWheelTimerHandle& Handle, float TimeScale);
+	// Hold every timer set by an object
+	void PauseTimersForObject(const UObject* Object);
+	// Release timers held by PauseTimersForObject
+	void UnPauseTimersForObject(const UObject* Object);
+
+	FORCEINLINE int32 GetNumTimers() const { return NumTimers; }
+	// Get the time the wheel has advanced since the world started, shared by every timer as a common clock
+	FORCEINLINE double GetTime() const { return Executing ? CallbackTime : Time; }
+
+protected:
+	// Get the entry a handle refers to, or null if the handle is stale
+	FWheelTimer* FindTimer(const FWheelTimerHandle& Handle);
+	const FWheelTimer* FindTimer(const FWheelTimerHandle& Handle) const;
+
+	// Place a timer into the slot for its expiration time
+	void Insert(int32 Index, double ExpireTime);
+	// Take a timer out of its slot
+	void Remove(int32 Index);
+	// Move a scheduled timer out of the wheel, keeping its remaining local time
+	void Hold(int32 Index);
+	// Put a held timer back into the wheel if it is able to run
+	void Release(int32 Index);
+	// Return an entry to the free list
+	void Free(int32 Index);
+
+	// Every timer entry, including free ones
+	TArray<FWheelTimer> Timers;
+	// Unused entries in Timers
+	TArray<int32> FreeTimers;
+	// The wheel slots, each holding the timers that expire on a tick mapping to the slot
+	TArray<TArray<int32>> Slots;
+	// Timers that expired during the current update, with the serial they expired with
+	TArray<TPair<int32, uint32>> Expired;
+
+	// The time the wheel has advanced since it was created
+	double Time;
+	// The last tick processed by the wheel
+	int64 CurrentTick;
+	// The deadline of the timer whose callback is running, timers set by the callback start from here so chained timers don't drift
+	double CallbackTime;
+	// Set while timer callbacks are running
+	bool Executing;
+
+	// The number of timers that haven't finished
+	int32 NumTimers;
+};
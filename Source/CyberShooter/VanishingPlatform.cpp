@@ -1,11 +1,15 @@
 // Copyright © 2020 Brian Faubion. All rights reserved.
 
 #include "VanishingPlatform.h"
+#include "VanishingPlatformSubsystem.h"
+#include "CyberShooter.h"
+
+#include "Engine/World.h"
 
 AVanishingPlatform::AVanishingPlatform()
 {
-	// Enable ticking for timers
-	PrimaryActorTick.bCanEverTick = true;
+	// Timers run on the timing wheel
+	PrimaryActorTick.bCanEverTick = false;
 
 	// Adjust mesh settings
 	UStaticMeshComponent* mesh = GetStaticMeshComponent();
@@ -17,40 +21,50 @@ AVanishingPlatform::AVanishingPlatform()
 	HiddenTime = 10.0f;
 	AlertDuration = 1.0f;
 	BlinkSpeed = 20;
+	MaterialBlink = false;
+	BlinkDataIndex = 0;
 	TimerOffset = 0.0f;
 
 	Active = true;
+	GroupIndex = INDEX_NONE;
 }
 
 void AVanishingPlatform::BeginPlay()
 {
 	Super::BeginPlay();
 
+	// Give the material the blink settings, a blink speed of zero turns blinking off
+	if (MaterialBlink)
+	{
+		UStaticMeshComponent* mesh = GetStaticMeshComponent();
+		mesh->SetCustomPrimitiveDataFloat(BlinkDataIndex + 1, AlertDuration);
+		mesh->SetCustomPrimitiveDataFloat(BlinkDataIndex + 2, (float)BlinkSpeed);
+	}
+
+	// Platforms that cycle on their own share a timer with matching platforms
+	if (CanJoinGroup())
+	{
+		JoinGroup();
+		if (GroupIndex != INDEX_NONE)
+			return;
+	}
+
 	// Set the initial state
 	Change(Solid);
-	Timer -= TimerOffset;
+
+	// Shorten the first cycle by the offset
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers != nullptr && timers->IsTimerActive(TimerHandle_ChangeTimer))
+	{
+		StartTimer(timers->GetTimerRemaining(TimerHandle_ChangeTimer) - TimerOffset);
+	}
 }
 
-void AVanishingPlatform::Tick(float DeltaSeconds)
+void AVanishingPlatform::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	if (!Active)
-		return;
+	LeaveGroup();
 
-	if (Timer > 0.0f)
-	{
-		// Manage the timer if it has been set
-		Timer -= DeltaSeconds;
-		if (Timer <= 0.0f)
-		{
-			Change(!Solid);
-		}
-		else if (Solid && Timer < AlertDuration)
-		{
-			// Blink when the timer is low
-			int state = (int)(Timer * BlinkSpeed) & 2;
-			SetActorHiddenInGame((bool)state);
-		}
-	}
+	Super::EndPlay(EndPlayReason);
 }
 
 bool AVanishingPlatform::IsStable() const
@@ -64,15 +78,21 @@ void AVanishingPlatform::TogglePlatform()
 		return;
 
 	// Force the platform to change states
-	Timer = 0.0f;
+	LeaveGroup();
 	Change(!Solid);
 }
 
 void AVanishingPlatform::SetTimer(float Time, bool Overwrite)
 {
-	if (Overwrite || Timer <= 0.0f)
+	// A group's timer counts as running
+	if (GroupIndex != INDEX_NONE && !Overwrite)
+		return;
+
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers != nullptr && (Overwrite || !timers->IsTimerActive(TimerHandle_ChangeTimer)))
 	{
-		Timer = Time;
+		LeaveGroup();
+		StartTimer(Time);
 	}
 }
 
@@ -80,8 +100,8 @@ void AVanishingPlatform::Activate()
 {
 	Active = true;
 
-	// Reset the timer then reveal the platform
-	Timer = 0.0f;
+	// Reveal the platform and restart the timer
+	LeaveGroup();
 	Change(true);
 }
 
@@ -90,6 +110,7 @@ void AVanishingPlatform::Deactivate()
 	Active = false;
 
 	// Hide the platform
+	LeaveGroup();
 	Change(false);
 }
 
@@ -98,18 +119,131 @@ void AVanishingPlatform::Deactivate()
 void AVanishingPlatform::Change(bool State)
 {
 	// Change the state of the platform
-	Solid = State;
-	SetActorHiddenInGame(!Solid);
-	SetActorEnableCollision(Solid);
+	ApplyState(State);
 
 	// Set the timer if needed
 	if (Solid)
 	{
-		Timer += SolidTime;
+		StartTimer(SolidTime);
 	}
 	else
 	{
-		Timer += HiddenTime;
+		StartTimer(HiddenTime);
+	}
+}
+
+void AVanishingPlatform::ApplyState(bool State)
+{
+	Solid = State;
+	SetActorHiddenInGame(!Solid);
+	SetActorEnableCollision(Solid);
+}
+
+void AVanishingPlatform::SetVanishTime(float Time)
+{
+	if (MaterialBlink)
+	{
+		// The material compares this against its own Time input, so blinking costs nothing on the game thread
+		const float vanish_time = (Solid && Time > 0.0f) ? GetWorld()->GetTimeSeconds() + Time : 0.0f;
+		GetStaticMeshComponent()->SetCustomPrimitiveDataFloat(BlinkDataIndex, vanish_time);
+		return;
+	}
+
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers == nullptr)
+		return;
+
+	// Stop any blink in progress and make sure the platform isn't left hidden by it
+	timers->ClearTimer(TimerHandle_AlertTimer);
+	timers->ClearTimer(TimerHandle_BlinkTimer);
+	SetActorHiddenInGame(!Solid);
+
+	// Blink when the timer is low
+	if (Solid && Time > 0.0f && AlertDuration > 0.0f && BlinkSpeed > 0)
+	{
+		if (Time > AlertDuration)
+		{
+			timers->SetTimer(TimerHandle_AlertTimer, this, &AVanishingPlatform::AlertTimeout, Time - AlertDuration);
+		}
+		else
+		{
+			AlertTimeout();
+		}
+	}
+}
+
+void AVanishingPlatform::StartTimer(float Time)
+{
+	StopTimer();
+
+	// Inactive platforms don't count down
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers == nullptr || !Active || Time <= 0.0f)
+	{
+		SetVanishTime(0.0f);
+		return;
+	}
+
+	timers->SetTimer(TimerHandle_ChangeTimer, this, &AVanishingPlatform::ChangeTimeout, Time);
+	SetVanishTime(Time);
+}
+
+void AVanishingPlatform::StopTimer()
+{
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers != nullptr)
+	{
+		timers->ClearTimer(TimerHandle_ChangeTimer);
+		timers->ClearTimer(TimerHandle_AlertTimer);
+		timers->ClearTimer(TimerHandle_BlinkTimer);
+	}
+}
+
+void AVanishingPlatform::ChangeTimeout()
+{
+	Change(!Solid);
+}
+
+void AVanishingPlatform::AlertTimeout()
+{
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers != nullptr)
+	{
+		timers->SetTimer(TimerHandle_BlinkTimer, this, &AVanishingPlatform::Blink, 2.0f / BlinkSpeed, true);
 	}
 }
 
+void AVanishingPlatform::Blink()
+{
+	SetActorHiddenInGame(!IsHidden());
+	INC_DWORD_STAT(STAT_BlinkVisibilityChanges);
+}
+
+bool AVanishingPlatform::CanJoinGroup() const
+{
+	return Active && SolidTime > 0.0f && HiddenTime > 0.0f;
+}
+
+void AVanishingPlatform::JoinGroup()
+{
+	UVanishingPlatformSubsystem* platforms = GetWorld()->GetSubsystem<UVanishingPlatformSubsystem>();
+	if (platforms != nullptr)
+	{
+		// Platforms that start hidden begin their cycle after the solid state
+		StopTimer();
+		GroupIndex = platforms->AddPlatform(this, SolidTime, HiddenTime, TimerOffset + (Solid ? 0.0f : SolidTime));
+	}
+}
+
+void AVanishingPlatform::LeaveGroup()
+{
+	if (GroupIndex == INDEX_NONE)
+		return;
+
+	UVanishingPlatformSubsystem* platforms = GetWorld()->GetSubsystem<UVanishingPlatformSubsystem>();
+	if (platforms != nullptr)
+	{
+		platforms->RemovePlatform(this, GroupIndex);
+	}
+	GroupIndex = INDEX_NONE;
+}
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "TimingWheelSubsystem.h"
+
 #include "CoreMinimal.h"
 #include "PhysicalStaticMesh.h"
 #include "VanishingPlatform.generated.h"
@@ -16,7 +18,7 @@ public:
 	AVanishingPlatform();
 
 	virtual void BeginPlay() override;
-	virtual void Tick(float DeltaSeconds) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	virtual bool IsStable() const override;
 
@@ -35,10 +37,33 @@ public:
 		void Deactivate();
 
 protected:
+	friend class UVanishingPlatformSubsystem;
+
 	/// Vanishing Platform Functions ///
 	
 	// Called to make the platform swap between visible and hidden states
 	void Change(bool State);
+	// Show or hide the platform without touching its timer
+	void ApplyState(bool State);
+	// Set how long until the platform vanishes so it can blink beforehand, zero if the platform isn't counting down
+	void SetVanishTime(float Time);
+	// Schedule the next state change
+	void StartTimer(float Time);
+	// Stop the state change and blink timers
+	void StopTimer();
+	// Called when the state timer runs out
+	void ChangeTimeout();
+	// Called when the platform is about to vanish
+	void AlertTimeout();
+	// Toggle visibility while vanishing
+	void Blink();
+
+	// Returns true if the platform cycles on its own and can share a group's timer
+	bool CanJoinGroup() const;
+	// Cycle with the group of platforms that have the same timings
+	void JoinGroup();
+	// Leave the platform's group so its timer can be controlled on its own
+	void LeaveGroup();
 
 	// Set to true when the platform is solid and false when it disappears
 	UPROPERTY(Category = "VanishingPlatform|State", EditAnywhere, BlueprintReadOnly)
@@ -63,10 +88,24 @@ protected:
 	// The rate at which the platform blinks when duration is low, in blinks per second
 	UPROPERTY(Category = "VanishingPlatform|Settings", EditAnywhere)
 		int32 BlinkSpeed;
+	// If set to true, the platform's material blinks from custom primitive data instead of the platform toggling its visibility on a timer
+	// The material must read the slots starting at BlinkDataIndex
+	UPROPERTY(Category = "VanishingPlatform|Settings", EditAnywhere)
+		bool MaterialBlink;
+	// The first of three custom primitive data slots holding the vanish time, alert duration and blink speed for the platform's material
+	// The vanish time is in world seconds, the material blinks while Time is within the alert duration before it
+	UPROPERTY(Category = "VanishingPlatform|Settings", EditAnywhere)
+		int32 BlinkDataIndex;
 	// Time removed from the timer when gameplay starts, in order to make vanishing platforms operate out of phase
 	UPROPERTY(Category = "VanishingPlatform|Settings", EditAnywhere)
 		float TimerOffset;
 
 	// The timer that tracks the state of the platform
-	float Timer;
+	FWheelTimerHandle TimerHandle_ChangeTimer;
+	// The timer that starts blinking before the platform vanishes
+	FWheelTimerHandle TimerHandle_AlertTimer;
+	// The timer that makes the platform blink
+	FWheelTimerHandle TimerHandle_BlinkTimer;
+	// The group the platform cycles with, or INDEX_NONE if it runs its own timer
+	int32 GroupIndex;
 };
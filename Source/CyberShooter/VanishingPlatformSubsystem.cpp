@@ -0,0 +1,126 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#include "VanishingPlatformSubsystem.h"
+#include "VanishingPlatform.h"
+#include "CyberShooter.h"
+
+#include "Engine/World.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Vanishing Platform Groups"), STAT_VanishingPlatformGroups, STATGROUP_CyberShooter);
+
+// The largest difference in seconds between timings that still share a group
+static const float GroupTolerance = 0.001f;
+
+void UVanishingPlatformSubsystem::Deinitialize()
+{
+	Groups.Empty();
+
+	Super::Deinitialize();
+}
+
+int32 UVanishingPlatformSubsystem::AddPlatform(AVanishingPlatform* Platform, float SolidTime, float HiddenTime, float Phase)
+{
+	const float period = SolidTime + HiddenTime;
+	if (Platform == nullptr || SolidTime <= 0.0f || HiddenTime <= 0.0f)
+		return INDEX_NONE;
+
+	// Wrap the phase into the first cycle
+	Phase = FMath::Fmod(Phase, period);
+	if (Phase < 0.0f)
+	{
+		Phase += period;
+	}
+
+	// Find a group with the same cycle
+	int32 index = Groups.IndexOfByPredicate([=](const FVanishingPlatformGroup& Group)
+	{
+		return FMath::IsNearlyEqual(Group.SolidTime, SolidTime, GroupTolerance) && FMath::IsNearlyEqual(Group.HiddenTime, HiddenTime, GroupTolerance) && FMath::IsNearlyEqual(Group.Phase, Phase, GroupTolerance);
+	});
+
+	if (index == INDEX_NONE)
+	{
+		index = Groups.AddDefaulted();
+		Groups[index].SolidTime = SolidTime;
+		Groups[index].HiddenTime = HiddenTime;
+		Groups[index].Phase = Phase;
+
+		SET_DWORD_STAT(STAT_VanishingPlatformGroups, Groups.Num());
+	}
+
+	// Groups stop their timer when they empty, so restart them from the clock
+	FVanishingPlatformGroup& group = Groups[index];
+	if (group.Platforms.Num() == 0)
+	{
+		StartGroup(index);
+	}
+	group.Platforms.Add(Platform);
+
+	float remaining = 0.0f;
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers != nullptr)
+	{
+		remaining = timers->GetTimerRemaining(group.TimerHandle);
+	}
+	Platform->ApplyState(group.Solid);
+	Platform->SetVanishTime(remaining);
+
+	return index;
+}
+
+void UVanishingPlatformSubsystem::RemovePlatform(AVanishingPlatform* Platform, int32 GroupIndex)
+{
+	if (!Groups.IsValidIndex(GroupIndex))
+		return;
+
+	FVanishingPlatformGroup& group = Groups[GroupIndex];
+	group.Platforms.RemoveSwap(Platform);
+
+	// Empty groups don't need to keep time
+	if (group.Platforms.Num() == 0)
+	{
+		UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+		if (timers != nullptr)
+		{
+			timers->ClearTimer(group.TimerHandle);
+		}
+	}
+}
+
+void UVanishingPlatformSubsystem::StartGroup(int32 GroupIndex)
+{
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers == nullptr)
+		return;
+
+	// Each cycle is the solid state followed by the hidden state
+	FVanishingPlatformGroup& group = Groups[GroupIndex];
+	const float period = group.SolidTime + group.HiddenTime;
+	const float position = (float)FMath::Fmod(timers->GetTime() + group.Phase, (double)period);
+
+	group.Solid = position < group.SolidTime;
+	ScheduleGroup(GroupIndex, group.Solid ? group.SolidTime - position : period - position);
+}
+
+void UVanishingPlatformSubsystem::GroupTimeout(int32 GroupIndex)
+{
+	FVanishingPlatformGroup& group = Groups[GroupIndex];
+	group.Solid = !group.Solid;
+
+	const float duration = group.Solid ? group.SolidTime : group.HiddenTime;
+	ScheduleGroup(GroupIndex, duration);
+
+	for (AVanishingPlatform* platform : group.Platforms)
+	{
+		platform->ApplyState(group.Solid);
+		platform->SetVanishTime(duration);
+	}
+}
+
+void UVanishingPlatformSubsystem::ScheduleGroup(int32 GroupIndex, float Delay)
+{
+	UTimingWheelSubsystem* timers = GetWorld()->GetSubsystem<UTimingWheelSubsystem>();
+	if (timers != nullptr)
+	{
+		timers->SetTimer(Groups[GroupIndex].TimerHandle, this, FTimerDelegate::CreateUObject(this, &UVanishingPlatformSubsystem::GroupTimeout, GroupIndex), FMath::Max(Delay, KINDA_SMALL_NUMBER), false, 1.0f);
+	}
+}
@@ -0,0 +1,61 @@
+// Copyright © 2020 Brian Faubion. All rights reserved.
+
+#pragma once
+
+#include "TimingWheelSubsystem.h"
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "VanishingPlatformSubsystem.generated.h"
+
+class AVanishingPlatform;
+
+// Vanishing platforms that share a cycle and change state together
+struct FVanishingPlatformGroup
+{
+	FVanishingPlatformGroup() : SolidTime(0.0f), HiddenTime(0.0f), Phase(0.0f), Solid(true) {}
+
+	// The length of each state
+	float SolidTime;
+	float HiddenTime;
+	// The offset of the group's cycle from the wheel clock, between zero and the period
+	float Phase;
+
+	// The platforms in the group
+	TArray<AVanishingPlatform*> Platforms;
+
+	// The current state of every platform in the group
+	bool Solid;
+	// The timer for the group's next state change
+	FWheelTimerHandle TimerHandle;
+};
+
+// Cycles vanishing platforms in groups driven by the timing wheel's clock
+// Platforms with the same timings and offset share one timer, so a room full of platforms only does work when a group changes state
+UCLASS()
+class CYBERSHOOTER_API UVanishingPlatformSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Add a platform to the group for its cycle and match the platform to the group's state, returns the group's index
+	// The phase is the platform's position in a cycle that starts with the solid state at wheel time zero
+	int32 AddPlatform(AVanishingPlatform* Platform, float SolidTime, float HiddenTime, float Phase);
+	// Remove a platform from its group
+	void RemovePlatform(AVanishingPlatform* Platform, int32 GroupIndex);
+
+	FORCEINLINE int32 GetNumGroups() const { return Groups.Num(); }
+
+protected:
+	// Put a group into the state matching the wheel clock and schedule its next change
+	void StartGroup(int32 GroupIndex);
+	// Change the state of every platform in a group
+	void GroupTimeout(int32 GroupIndex);
+	// Schedule a group's next state change
+	void ScheduleGroup(int32 GroupIndex, float Delay);
+
+	// Every group, including groups whose platforms have all left
+	TArray<FVanishingPlatformGroup> Groups;
+};
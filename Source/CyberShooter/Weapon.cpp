@@ -1,6 +1,70 @@
 // Copyright © 2020 Brian Faubion. All rights reserved.
 
 #include "Weapon.h"
+#include "CyberShooter.h"
+
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+static FAutoConsoleCommand SpreadBenchmarkCommand(
+	TEXT("cs.SpreadBenchmark"),
+	TEXT("Time building bullet transforms for random shots with per-bullet rotations against the baked spread table. Takes an optional bullet count, defaulting to 5."),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const int32 num_bullets = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 5;
+		const int32 shots = 100000;
+		const float offset = 15.0f;
+		const float gun_offset = 100.0f;
+
+		UWeapon* weapon = NewObject<UWeapon>();
+		weapon->NumBullets = num_bullets;
+		weapon->BulletOffset = offset;
+		weapon->FanBullets = true;
+
+		// Random fire directions and up vectors for every shot
+		FRandomStream stream(num_bullets);
+		TArray<FVector> directions, ups;
+		for (int32 i = 0; i < shots; ++i)
+		{
+			directions.Add(stream.GetUnitVector());
+			ups.Add(FVector::CrossProduct(directions[i], stream.GetUnitVector()).GetSafeNormal());
+		}
+
+		// Accumulate the results so the work can't be skipped
+		FVector sum(0.0f);
+
+		// Rotate the fire direction around the up vector for every bullet
+		double start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < shots; ++i)
+		{
+			float angle = -(offset * (num_bullets - 1)) / 2.0f;
+			for (int32 j = 0; j < num_bullets; ++j)
+			{
+				const FRotator rotation = directions[i].RotateAngleAxis(angle, ups[i]).Rotation();
+				sum += rotation.RotateVector(FVector(gun_offset, 0.0f, 0.0f)) + rotation.Vector();
+				angle += offset;
+			}
+		}
+		const double rotate_time = FPlatformTime::Seconds() - start;
+
+		// Compose one shot rotation with each table entry
+		start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < shots; ++i)
+		{
+			const FQuat shot = FRotationMatrix::MakeFromXZ(directions[i], ups[i]).ToQuat();
+			const TArray<FWeaponSpread>& spread = weapon->GetSpreadTable();
+			for (int32 j = 0; j < spread.Num(); ++j)
+			{
+				sum += (shot * spread[j].Muzzle).GetForwardVector() * gun_offset + (shot * spread[j].Direction).Rotator().Vector();
+			}
+		}
+		const double table_time = FPlatformTime::Seconds() - start;
+
+		weapon->MarkPendingKill();
+
+		UE_LOG(LogCyberShooter, Log, TEXT("%d shots of %d bullets: rotations %.3f ms, spread table %.3f ms (%f)"), shots, num_bullets, rotate_time * 1000.0, table_time * 1000.0, sum.X);
+	}));
 
 UWeapon::UWeapon()
 {
@@ -20,4 +84,54 @@ UWeapon::UWeapon()
 	BulletOffset = 15.0f;
 	Recoil = 0.0f;
 	FanBullets = true;
+
+	BakedNumBullets = 0;
+	BakedBulletOffset = 0.0f;
+	BakedFanBullets = false;
+}
+
+void UWeapon::PostLoad()
+{
+	Super::PostLoad();
+
+	BakeSpreadTable();
+}
+
+#if WITH_EDITOR
+void UWeapon::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	BakeSpreadTable();
+}
+#endif
+
+const TArray<FWeaponSpread>& UWeapon::GetSpreadTable()
+{
+	// The bullet settings can be changed from blueprints at any time
+	if (NumBullets != BakedNumBullets || BulletOffset != BakedBulletOffset || FanBullets != BakedFanBullets)
+	{
+		BakeSpreadTable();
+	}
+
+	return SpreadTable;
+}
+
+void UWeapon::BakeSpreadTable()
+{
+	SpreadTable.SetNum(FMath::Max(NumBullets, 0));
+
+	// Fan the bullets evenly around the fire direction
+	float angle = -(BulletOffset * (NumBullets - 1)) / 2.0f;
+	for (int32 i = 0; i < SpreadTable.Num(); ++i)
+	{
+		SpreadTable[i].Muzzle = FQuat(FVector::UpVector, FMath::DegreesToRadians(angle));
+		SpreadTable[i].Direction = FanBullets ? SpreadTable[i].Muzzle : FQuat::Identity;
+
+		angle += BulletOffset;
+	}
+
+	BakedNumBullets = NumBullets;
+	BakedBulletOffset = BulletOffset;
+	BakedFanBullets = FanBullets;
 }
\ No newline at end of file
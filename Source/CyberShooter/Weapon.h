@@ -6,6 +6,17 @@
 #include "Engine/DataAsset.h"
 #include "Weapon.generated.h"
 
+// One bullet of a weapon's spread pattern, in a space where X is the fire direction and Z is the shooter's up vector
+struct FWeaponSpread
+{
+	FWeaponSpread() : Muzzle(FQuat::Identity), Direction(FQuat::Identity) {}
+
+	// The rotation from the fire direction to the point on the gun offset circle the bullet spawns at
+	FQuat Muzzle;
+	// The rotation from the fire direction to the direction the bullet travels
+	FQuat Direction;
+};
+
 // A weapon that can be used by the player or an enemy
 UCLASS(BlueprintType)
 class CYBERSHOOTER_API UWeapon : public UDataAsset
@@ -15,6 +26,14 @@ class CYBERSHOOTER_API UWeapon : public UDataAsset
 public:
 	UWeapon();
 
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	// Get the spread pattern for a shot, baking it first if the bullet settings have changed
+	const TArray<FWeaponSpread>& GetSpreadTable();
+
 	// The UI icon for the weapon
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite)
 		UTexture2D* Icon;
@@ -48,4 +67,15 @@ public:
 	// If true shots will be fired at the same angle as BulletOffset, otherwise they all fire forward
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite)
 		bool FanBullets;
+
+protected:
+	// Build the spread table from the bullet count, offset and fan setting
+	void BakeSpreadTable();
+
+	// The spread pattern for every bullet in a shot
+	TArray<FWeaponSpread> SpreadTable;
+	// The bullet settings the spread table was baked from
+	int32 BakedNumBullets;
+	float BakedBulletOffset;
+	bool BakedFanBullets;
 };